@@ -24,6 +24,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -44,6 +45,9 @@ namespace Audio {
 #pragma mark --- MP3 (MAD) stream ---
 #pragma mark -
 
+// Seeking through a table of the frame offsets is sample accurate, but it
+// hasn't been checked against a linear decode of real streams yet. Until
+// then the streams seek by time, unless this is built with -DMP3_SEEK_TABLE.
 
 class MP3Stream : public SeekableAudioStream {
 protected:
@@ -66,11 +70,24 @@ protected:
 	mad_synth _synth;
 
 	enum {
-		BUFFER_SIZE = 5 * 8192
+		BUFFER_SIZE = 5 * 8192,
+		// The most a Layer III frame can take from the preceding ones
+		MAX_RESERVOIR_SIZE = 511
 	};
 
 	// This buffer contains a slab of input data
 	byte _buf[BUFFER_SIZE + MAD_BUFFER_GUARD];
+	// Position of the buffer in the input stream
+	uint32 _bufPos;
+
+	struct SeekPoint {
+		uint32 offset;	// Of the frame header in the input stream
+		uint32 sample;	// First sample of the frame
+	};
+
+	// Every frame of the stream, in order, found when computing the length
+	Common::Array<SeekPoint> _seekTable;
+	uint _seekRate;
 
 public:
 	MP3Stream(Common::SeekableReadStream *inStream,
@@ -89,9 +106,12 @@ protected:
 	void decodeMP3Data();
 	void readMP3Data();
 
-	void initStream();
+	void initStream(uint32 offset = 0);
 	void readHeader();
 	void deinitStream();
+
+	bool seekByTable(const Timestamp &where);
+	uint32 getFrameOffset() const { return _bufPos + (_stream.this_frame - _buf); }
 };
 
 MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -99,18 +119,47 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_posInFrame(0),
 	_state(MP3_STATE_INIT),
 	_length(0, 1000),
-	_totalTime(mad_timer_zero) {
+	_totalTime(mad_timer_zero),
+	_bufPos(0),
+	_seekRate(0) {
 
 	// The MAD_BUFFER_GUARD must always contain zeros (the reason
 	// for this is that the Layer III Huffman decoder of libMAD
 	// may read a few bytes beyond the end of the input buffer).
 	memset(_buf + BUFFER_SIZE, 0, MAD_BUFFER_GUARD);
 
-	// Calculate the length of the stream
+	// Calculate the length of the stream, noting where every frame starts
+	// for seeking
 	initStream();
 
-	while (_state != MP3_STATE_EOS)
+	uint32 sample = 0;
+#ifdef MP3_SEEK_TABLE
+	bool tableValid = true;
+#else
+	bool tableValid = false;
+#endif
+	while (_state != MP3_STATE_EOS) {
 		readHeader();
+		if (_state == MP3_STATE_EOS)
+			break;
+		if (!tableValid)
+			continue;
+
+		if (_seekRate == 0) {
+			_seekRate = _frame.header.samplerate;
+		} else if (_seekRate != _frame.header.samplerate) {
+			// Can't tell the samples apart, seek by time
+			_seekTable.clear();
+			tableValid = false;
+			continue;
+		}
+
+		SeekPoint point;
+		point.offset = getFrameOffset();
+		point.sample = sample;
+		_seekTable.push_back(point);
+		sample += 32 * MAD_NSBSAMPLES(&_frame.header);
+	}
 
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
@@ -194,6 +243,7 @@ void MP3Stream::readMP3Data() {
 		assert(remaining < BUFFER_SIZE);	// Paranoia check
 		memmove(_buf, _stream.next_frame, remaining);
 	}
+	_bufPos = _inStream->pos() - remaining;
 
 	// Try to read the next block
 	uint32 size = _inStream->read(_buf + remaining, BUFFER_SIZE - remaining);
@@ -215,6 +265,9 @@ bool MP3Stream::seek(const Timestamp &where) {
 		return false;
 	}
 
+	if (!_seekTable.empty())
+		return seekByTable(where);
+
 	const uint32 time = where.msecs();
 
 	mad_timer_t destination;
@@ -231,7 +284,51 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
-void MP3Stream::initStream() {
+bool MP3Stream::seekByTable(const Timestamp &where) {
+	const uint32 sample = where.convertToFramerate(_seekRate).totalNumberOfFrames();
+
+	// The last frame starting at or before the sample
+	uint lo = 0, hi = _seekTable.size();
+	while (hi - lo > 1) {
+		uint mid = (lo + hi) / 2;
+		if (_seekTable[mid].sample <= sample)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	const SeekPoint &target = _seekTable[lo];
+
+	// The main data of the frame may begin in the preceding ones, which are
+	// decoded first to fill the bit reservoir. One more frame makes up for
+	// their headers, which aren't part of the reservoir, and another one
+	// primes the synthesis filter.
+	uint first = lo;
+	while (first > 0 && target.offset - _seekTable[first].offset < MAX_RESERVOIR_SIZE)
+		first--;
+	first = (first > 2) ? first - 2 : 0;
+
+	initStream(_seekTable[first].offset);
+
+	do {
+		decodeMP3Data();
+	} while (_state != MP3_STATE_EOS && getFrameOffset() < target.offset);
+
+	if (_state == MP3_STATE_EOS)
+		return false;
+
+	if (getFrameOffset() == target.offset) {
+		_posInFrame = MIN<uint32>(sample - target.sample, _synth.pcm.length);
+	} else {
+		// mad_frame_decode failed on the target frame and moved on to the next
+		// one, usually with MAD_ERROR_BADDATAPTR because the priming frames
+		// didn't fill the bit reservoir far enough back
+		debug(3, "MP3Stream: Couldn't decode the frame at %u when seeking to sample %u, resuming at %u",
+		      target.offset, sample, getFrameOffset());
+	}
+	return true;
+}
+
+void MP3Stream::initStream(uint32 offset) {
 	if (_state != MP3_STATE_INIT)
 		deinitStream();
 
@@ -241,7 +338,7 @@ void MP3Stream::initStream() {
 	mad_synth_init(&_synth);
 
 	// Reset the stream data
-	_inStream->seek(0, SEEK_SET);
+	_inStream->seek(offset, SEEK_SET);
 	_totalTime = mad_timer_zero;
 	_posInFrame = 0;
 
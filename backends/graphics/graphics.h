@@ -70,6 +70,8 @@ public:
 	virtual void unlockScreen() = 0;
 	virtual void fillScreen(uint32 col) = 0;
 	virtual void updateScreen() = 0;
+	// ResidualVM specific method
+	virtual void updateScreenRects(const Common::Rect *rects, uint numRects) { updateScreen(); }
 	virtual void setShakePos(int shakeOffset) = 0;
 	virtual void setFocusRectangle(const Common::Rect& rect) = 0;
 	virtual void clearFocusRectangle() = 0;
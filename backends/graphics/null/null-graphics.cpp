@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/null/null-graphics.h"
+
+#include "common/textconsole.h"
+
+static const OSystem::GraphicsMode s_noGraphicsModes[] = {
+	{0, 0, 0}
+};
+
+NullGraphicsManager::NullGraphicsManager() :
+		_format(2, 5, 6, 5, 0, 11, 5, 0, 0), _overlayVisible(false), _screenChangeCount(0) {
+}
+
+NullGraphicsManager::~NullGraphicsManager() {
+	_screen.free();
+	_overlay.free();
+}
+
+const OSystem::GraphicsMode *NullGraphicsManager::getSupportedGraphicsModes() const {
+	return s_noGraphicsModes;
+}
+
+#ifdef USE_RGB_COLOR
+Common::List<Graphics::PixelFormat> NullGraphicsManager::getSupportedFormats() const {
+	Common::List<Graphics::PixelFormat> formats;
+	formats.push_back(_format);
+	return formats;
+}
+#endif
+
+void NullGraphicsManager::launcherInitSize(uint w, uint h) {
+	setupScreen(w, h, false, false);
+}
+
+Graphics::PixelBuffer NullGraphicsManager::setupScreen(int screenW, int screenH, bool fullscreen, bool accel3d) {
+	if (accel3d)
+		warning("NullGraphicsManager: 3D acceleration is not supported");
+
+	_screen.free();
+	_screen.create(screenW, screenH, _format);
+	memset(_screen.pixels, 0, _screen.pitch * _screen.h);
+	_overlay.free();
+	_overlay.create(screenW, screenH, _format);
+	_screenChangeCount++;
+
+	return Graphics::PixelBuffer(_format, (byte *)_screen.pixels);
+}
+
+void NullGraphicsManager::showOverlay() {
+	if (_overlayVisible)
+		return;
+
+	_overlayVisible = true;
+	clearOverlay();
+}
+
+void NullGraphicsManager::hideOverlay() {
+	_overlayVisible = false;
+}
+
+void NullGraphicsManager::clearOverlay() {
+	// Like the software SDL renderer, show the game screen behind the GUI
+	if (_overlayVisible && _overlay.pixels)
+		memcpy(_overlay.pixels, _screen.pixels, _screen.pitch * _screen.h);
+}
+
+void NullGraphicsManager::grabOverlay(void *buf, int pitch) {
+	const byte *src = (const byte *)_overlay.pixels;
+	byte *dst = (byte *)buf;
+	for (int y = 0; y < _overlay.h; ++y) {
+		memcpy(dst, src, _overlay.w * _format.bytesPerPixel);
+		src += _overlay.pitch;
+		dst += pitch;
+	}
+}
+
+void NullGraphicsManager::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {
+	const byte *src = (const byte *)buf;
+
+	// Clip the coordinates
+	if (x < 0) {
+		w += x;
+		src -= x * _format.bytesPerPixel;
+		x = 0;
+	}
+	if (y < 0) {
+		h += y;
+		src -= y * pitch;
+		y = 0;
+	}
+	if (w > _overlay.w - x)
+		w = _overlay.w - x;
+	if (h > _overlay.h - y)
+		h = _overlay.h - y;
+	if (w <= 0 || h <= 0)
+		return;
+
+	byte *dst = (byte *)_overlay.getBasePtr(x, y);
+	for (int i = 0; i < h; ++i) {
+		memcpy(dst, src, w * _format.bytesPerPixel);
+		src += pitch;
+		dst += _overlay.pitch;
+	}
+}
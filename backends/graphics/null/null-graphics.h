@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_NULL_H
+#define BACKENDS_GRAPHICS_NULL_H
+
+#include "backends/graphics/graphics.h"
+#include "graphics/pixelbuffer.h"
+#include "graphics/surface.h"
+
+/**
+ * Graphics manager which renders to memory only, for running without a
+ * display. The screen is a 16 bit buffer that software renderers draw
+ * into; the overlay is kept in a separate surface so that the GUI works
+ * too, but nothing is ever shown.
+ */
+class NullGraphicsManager : public GraphicsManager {
+public:
+	NullGraphicsManager();
+	virtual ~NullGraphicsManager();
+
+	virtual bool hasFeature(OSystem::Feature f) { return false; }
+	virtual void setFeatureState(OSystem::Feature f, bool enable) {}
+	virtual bool getFeatureState(OSystem::Feature f) { return false; }
+
+	virtual const OSystem::GraphicsMode *getSupportedGraphicsModes() const;
+	virtual int getDefaultGraphicsMode() const { return 0; }
+	virtual bool setGraphicsMode(int mode) { return true; }
+	virtual void resetGraphicsScale() {}
+	virtual int getGraphicsMode() const { return 0; }
+#ifdef USE_RGB_COLOR
+	virtual Graphics::PixelFormat getScreenFormat() const { return _format; }
+	virtual Common::List<Graphics::PixelFormat> getSupportedFormats() const;
+#endif
+	virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) {}
+	virtual int getScreenChangeID() const { return _screenChangeCount; }
+
+	virtual void beginGFXTransaction() {}
+	virtual OSystem::TransactionError endGFXTransaction() { return OSystem::kTransactionSuccess; }
+
+	virtual void launcherInitSize(uint w, uint h);
+	virtual Graphics::PixelBuffer setupScreen(int screenW, int screenH, bool fullscreen, bool accel3d);
+
+	virtual int16 getHeight() { return _screen.h; }
+	virtual int16 getWidth() { return _screen.w; }
+	virtual void setPalette(const byte *colors, uint start, uint num) {}
+	virtual void grabPalette(byte *colors, uint start, uint num) {}
+	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual Graphics::Surface *lockScreen() { return &_screen; }
+	virtual void unlockScreen() {}
+	virtual void fillScreen(uint32 col) {}
+	virtual void updateScreen() {}
+	virtual void setShakePos(int shakeOffset) {}
+	virtual void setFocusRectangle(const Common::Rect& rect) {}
+	virtual void clearFocusRectangle() {}
+
+	virtual void showOverlay();
+	virtual void hideOverlay();
+	virtual Graphics::PixelFormat getOverlayFormat() const { return _format; }
+	virtual void clearOverlay();
+	virtual void grabOverlay(void *buf, int pitch);
+	virtual void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h);
+	virtual int16 getOverlayHeight() { return _overlay.h; }
+	virtual int16 getOverlayWidth() { return _overlay.w; }
+
+	virtual bool showMouse(bool visible) { return !visible; }
+	virtual void warpMouse(int x, int y) {}
+	virtual void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) {}
+	virtual void setCursorPalette(const byte *colors, uint start, uint num) {}
+	virtual bool lockMouse(bool lock) { return false; }
+
+	/** The screen the game draws into, for checking what was rendered. */
+	const Graphics::Surface &getScreen() const { return _screen; }
+
+private:
+	Graphics::PixelFormat _format;
+	Graphics::Surface _screen;
+	Graphics::Surface _overlay;
+	bool _overlayVisible;
+	int _screenChangeCount;
+};
+
+#endif
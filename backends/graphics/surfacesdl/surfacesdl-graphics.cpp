@@ -284,6 +284,9 @@ Graphics::PixelBuffer SurfaceSdlGraphicsManager::setupScreen(int screenW, int sc
 	if (!_overlayscreen)
 		error("allocating _overlayscreen failed");
 
+	_overlayDirty = true;
+	_overlayDirtyRects.clear();
+
 	/*_overlayFormat.bytesPerPixel = _overlayscreen->format->BytesPerPixel;
 
 // 	For some reason the values below aren't right, at least on my system
@@ -314,43 +317,9 @@ void SurfaceSdlGraphicsManager::updateScreen() {
 #ifdef USE_OPENGL
 	if (_opengl) {
 		if (_overlayVisible) {
-			if (_overlayDirty) {
-				// remove if already exist
-				if (_overlayNumTex > 0) {
-					glDeleteTextures(_overlayNumTex, _overlayTexIds);
-					delete[] _overlayTexIds;
-					_overlayNumTex = 0;
-				}
-
-				_overlayNumTex = ((_overlayWidth + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE) *
-								((_overlayHeight + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE);
-				_overlayTexIds = new GLuint[_overlayNumTex];
-				glGenTextures(_overlayNumTex, _overlayTexIds);
-				for (int i = 0; i < _overlayNumTex; i++) {
-					glBindTexture(GL_TEXTURE_2D, _overlayTexIds[i]);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-					glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, BITMAP_TEXTURE_SIZE, BITMAP_TEXTURE_SIZE, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, NULL);
-				}
-
-				glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
-				glPixelStorei(GL_UNPACK_ROW_LENGTH, _overlayWidth);
-
-				int curTexIdx = 0;
-				for (int y = 0; y < _overlayHeight; y += BITMAP_TEXTURE_SIZE) {
-					for (int x = 0; x < _overlayWidth; x += BITMAP_TEXTURE_SIZE) {
-						int t_width = (x + BITMAP_TEXTURE_SIZE >= _overlayWidth) ? (_overlayWidth - x) : BITMAP_TEXTURE_SIZE;
-						int t_height = (y + BITMAP_TEXTURE_SIZE >= _overlayHeight) ? (_overlayHeight - y) : BITMAP_TEXTURE_SIZE;
-						glBindTexture(GL_TEXTURE_2D, _overlayTexIds[curTexIdx]);
-						glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, t_width, t_height, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, (byte *)_overlayscreen->pixels + (y * 2 * _overlayWidth) + (2 * x));
-						curTexIdx++;
-					}
-				}
-				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-				glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-			}
+			if (_overlayNumTex == 0)
+				createOverlayTextures();
+			updateOverlayTextures();
 
 			// Save current state
 			glPushAttrib(GL_TRANSFORM_BIT | GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_SCISSOR_BIT);
@@ -412,25 +381,169 @@ void SurfaceSdlGraphicsManager::updateScreen() {
 #endif
 	{
 		if (_overlayVisible) {
+			// The game doesn't draw while the overlay is shown, so only the
+			// parts of the overlay changed since the last update need to be
+			// converted to the screen and presented. Flipping swaps in a
+			// back buffer which doesn't hold the previous frame, though.
+			if (_screen->flags & SDL_DOUBLEBUF)
+				_overlayDirty = true;
+			prepareOverlayDirtyRects();
+			if (_overlayDirtyRects.empty())
+				return;
+
 			SDL_LockSurface(_screen);
 			SDL_LockSurface(_overlayscreen);
-			Graphics::PixelBuffer srcBuf(_overlayFormat, (byte *)_overlayscreen->pixels);
-			Graphics::PixelBuffer dstBuf(_screenFormat, (byte *)_screen->pixels);
-			int h = _overlayHeight;
-
-			do {
-				dstBuf.copyBuffer(0, _overlayWidth, srcBuf);
-
-				srcBuf.shiftBy(_overlayWidth);
-				dstBuf.shiftBy(_overlayWidth);
-			} while (--h);
+			for (uint i = 0; i < _overlayDirtyRects.size(); i++) {
+				const Common::Rect &r = _overlayDirtyRects[i];
+				Graphics::PixelBuffer srcBuf(_overlayFormat, (byte *)_overlayscreen->pixels);
+				Graphics::PixelBuffer dstBuf(_screenFormat, (byte *)_screen->pixels);
+				srcBuf.shiftBy(r.top * _overlayWidth);
+				dstBuf.shiftBy(r.top * _overlayWidth);
+				int h = r.height();
+
+				do {
+					dstBuf.copyBuffer(r.left, r.width(), srcBuf);
+
+					srcBuf.shiftBy(_overlayWidth);
+					dstBuf.shiftBy(_overlayWidth);
+				} while (--h);
+			}
 			SDL_UnlockSurface(_screen);
 			SDL_UnlockSurface(_overlayscreen);
+
+			if (!(_screen->flags & SDL_DOUBLEBUF)) {
+				SDL_Rect *sdlRects = new SDL_Rect[_overlayDirtyRects.size()];
+				for (uint i = 0; i < _overlayDirtyRects.size(); i++) {
+					sdlRects[i].x = _overlayDirtyRects[i].left;
+					sdlRects[i].y = _overlayDirtyRects[i].top;
+					sdlRects[i].w = _overlayDirtyRects[i].width();
+					sdlRects[i].h = _overlayDirtyRects[i].height();
+				}
+				SDL_UpdateRects(_screen, _overlayDirtyRects.size(), sdlRects);
+				delete[] sdlRects;
+				_overlayDirtyRects.clear();
+				return;
+			}
+			_overlayDirtyRects.clear();
 		}
 		SDL_Flip(_screen);
 	}
 }
 
+// Above this many rects the overlay is refreshed in one go
+#define MAX_OVERLAY_DIRTY_RECTS 32
+
+void SurfaceSdlGraphicsManager::addOverlayDirtyRect(const Common::Rect &rect) {
+	if (_overlayDirty)
+		return;
+
+	// Merge with a rect it overlaps, as the GUI often redraws widgets
+	// inside the dialog it just redrew
+	for (uint i = 0; i < _overlayDirtyRects.size(); i++) {
+		if (_overlayDirtyRects[i].intersects(rect)) {
+			_overlayDirtyRects[i].extend(rect);
+			return;
+		}
+	}
+
+	if (_overlayDirtyRects.size() >= MAX_OVERLAY_DIRTY_RECTS) {
+		_overlayDirty = true;
+		_overlayDirtyRects.clear();
+		return;
+	}
+	_overlayDirtyRects.push_back(rect);
+}
+
+void SurfaceSdlGraphicsManager::prepareOverlayDirtyRects() {
+	if (_overlayDirty) {
+		_overlayDirtyRects.clear();
+		_overlayDirtyRects.push_back(Common::Rect(_overlayWidth, _overlayHeight));
+		_overlayDirty = false;
+	}
+}
+
+#ifdef USE_OPENGL
+void SurfaceSdlGraphicsManager::createOverlayTextures() {
+	_overlayNumTex = ((_overlayWidth + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE) *
+					((_overlayHeight + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE);
+	_overlayTexIds = new GLuint[_overlayNumTex];
+	glGenTextures(_overlayNumTex, _overlayTexIds);
+	for (int i = 0; i < _overlayNumTex; i++) {
+		glBindTexture(GL_TEXTURE_2D, _overlayTexIds[i]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, BITMAP_TEXTURE_SIZE, BITMAP_TEXTURE_SIZE, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, NULL);
+	}
+
+	// The new textures hold nothing yet
+	_overlayDirty = true;
+}
+
+void SurfaceSdlGraphicsManager::updateOverlayTextures() {
+	prepareOverlayDirtyRects();
+	if (_overlayDirtyRects.empty())
+		return;
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, _overlayWidth);
+
+	int curTexIdx = 0;
+	for (int y = 0; y < _overlayHeight; y += BITMAP_TEXTURE_SIZE) {
+		for (int x = 0; x < _overlayWidth; x += BITMAP_TEXTURE_SIZE) {
+			// Upload the part of the tile covering all the changes in it
+			Common::Rect tile(x, y, MIN(x + BITMAP_TEXTURE_SIZE, _overlayWidth), MIN(y + BITMAP_TEXTURE_SIZE, _overlayHeight));
+			Common::Rect dirty;
+			for (uint i = 0; i < _overlayDirtyRects.size(); i++) {
+				if (!tile.intersects(_overlayDirtyRects[i]))
+					continue;
+				Common::Rect r = _overlayDirtyRects[i];
+				r.clip(tile);
+				if (dirty.isEmpty())
+					dirty = r;
+				else
+					dirty.extend(r);
+			}
+
+			if (!dirty.isEmpty()) {
+				glBindTexture(GL_TEXTURE_2D, _overlayTexIds[curTexIdx]);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.left - x, dirty.top - y, dirty.width(), dirty.height(), GL_RGB, GL_UNSIGNED_SHORT_5_6_5,
+				                (byte *)_overlayscreen->pixels + (dirty.top * 2 * _overlayWidth) + (2 * dirty.left));
+			}
+			curTexIdx++;
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+	_overlayDirtyRects.clear();
+}
+#endif
+
+void SurfaceSdlGraphicsManager::updateScreenRects(const Common::Rect *rects, uint numRects) {
+	// The overlay is drawn over the whole screen, and double buffered
+	// surfaces must be flipped
+	bool partial = !_overlayVisible && !(_screen->flags & SDL_DOUBLEBUF);
+#ifdef USE_OPENGL
+	partial = partial && !_opengl;
+#endif
+	if (!partial) {
+		updateScreen();
+		return;
+	}
+
+	SDL_Rect *sdlRects = new SDL_Rect[numRects];
+	for (uint i = 0; i < numRects; i++) {
+		sdlRects[i].x = rects[i].left;
+		sdlRects[i].y = rects[i].top;
+		sdlRects[i].w = rects[i].width();
+		sdlRects[i].h = rects[i].height();
+	}
+	SDL_UpdateRects(_screen, numRects, sdlRects);
+	delete[] sdlRects;
+}
+
 void SurfaceSdlGraphicsManager::copyRectToScreen(const void *src, int pitch, int x, int y, int w, int h) {
 	// ResidualVM: not use it
 }
@@ -604,6 +717,8 @@ void SurfaceSdlGraphicsManager::copyRectToOverlay(const void *buf, int pitch, in
 	if (w <= 0 || h <= 0)
 		return;
 
+	addOverlayDirtyRect(Common::Rect(x, y, x + w, y + h));
+
 	if (SDL_LockSurface(_overlayscreen) == -1)
 		error("SDL_LockSurface failed: %s", SDL_GetError());
 
@@ -32,7 +32,9 @@
 #include "backends/graphics/sdl/sdl-graphics.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
+#include "common/array.h"
 #include "common/events.h"
+#include "common/rect.h"
 #include "common/system.h"
 
 #include "backends/events/sdl/sdl-events.h"
@@ -90,6 +92,7 @@ public:
 	virtual void unlockScreen();
 	virtual void fillScreen(uint32 col);
 	virtual void updateScreen();
+	virtual void updateScreenRects(const Common::Rect *rects, uint numRects);
 	virtual void setShakePos(int shakeOffset);
 	virtual void setFocusRectangle(const Common::Rect& rect);
 	virtual void clearFocusRectangle();
@@ -143,10 +146,18 @@ protected:
 	bool _overlayVisible;
 	Graphics::PixelFormat _overlayFormat;
 	int _overlayWidth, _overlayHeight;
+	/** The whole overlay must be refreshed */
 	bool _overlayDirty;
+	/** Parts of the overlay changed since the last update */
+	Common::Array<Common::Rect> _overlayDirtyRects;
+	void addOverlayDirtyRect(const Common::Rect &rect);
+	/** Make the dirty rects cover the whole overlay if it is all dirty */
+	void prepareOverlayDirtyRects();
 #ifdef USE_OPENGL
 	int _overlayNumTex;
 	GLuint *_overlayTexIds;
+	void createOverlayTextures();
+	void updateOverlayTextures();
 #endif
 
 #ifdef USE_OPENGL
@@ -156,6 +156,10 @@ void ModularBackend::updateScreen() {
 	_graphicsManager->updateScreen();
 }
 
+void ModularBackend::updateScreenRects(const Common::Rect *rects, uint numRects) {
+	_graphicsManager->updateScreenRects(rects, numRects);
+}
+
 void ModularBackend::setShakePos(int shakeOffset) {
 	_graphicsManager->setShakePos(shakeOffset);
 }
@@ -89,6 +89,8 @@ public:
 	virtual void unlockScreen();
 	virtual void fillScreen(uint32 col);
 	virtual void updateScreen();
+// ResidualVM specific method
+	virtual void updateScreenRects(const Common::Rect *rects, uint numRects);
 	virtual void setShakePos(int shakeOffset);
 	virtual void setFocusRectangle(const Common::Rect& rect);
 	virtual void clearFocusRectangle();
@@ -0,0 +1,331 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Allow use of stuff in <time.h> and <sys/time.h>
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+// Allow writing the log messages to stdout and stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_FILE
+#define FORBIDDEN_SYMBOL_EXCEPTION_stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+
+#include "common/scummsys.h"
+
+#if defined(USE_NULL_DRIVER)
+
+#include "backends/modular-backend.h"
+#include "base/main.h"
+
+#include "backends/audiocd/default/default-audiocd.h"
+#include "backends/events/default/default-events.h"
+#include "backends/graphics/null/null-graphics.h"
+#include "backends/mutex/null/null-mutex.h"
+#include "backends/saves/default/default-saves.h"
+#include "backends/timer/default/default-timer.h"
+#include "audio/mixer_intern.h"
+#include "common/config-manager.h"
+#include "common/EventRecorder.h"
+#include "common/file.h"
+#include "common/textconsole.h"
+
+#if defined(POSIX)
+#include "backends/fs/posix/posix-fs-factory.h"
+#include "backends/saves/posix/posix-saves.h"
+#endif
+
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+
+/**
+ * Backend without any display, input or sound device, meant for running
+ * benchmarks and regression checks unattended.
+ *
+ * Time is virtual: delays return immediately and just move the clock
+ * forward, so a run takes as long as the work done in it and gives the
+ * same results on every machine. Timers and the mixer are driven from
+ * that clock. Input comes from the event recorder; start the game with
+ * --record-mode=playback to replay a recorded session.
+ *
+ * The following configuration keys are understood:
+ *  - headless_frames: quit after this many frames have been presented
+ *  - headless_frame_log: file to write one "frame microseconds hash" line
+ *    to for every presented frame, the time being the real time spent on it
+ *  - headless_frame_hash: hash the screen contents for the frame log, to
+ *    detect rendering changes
+ */
+class OSystem_NULL : public ModularBackend, Common::EventSource {
+public:
+	OSystem_NULL();
+	virtual ~OSystem_NULL();
+
+	virtual void initBackend();
+
+	virtual bool pollEvent(Common::Event &event);
+	virtual Common::EventSource *getDefaultEventSource() { return this; }
+
+	virtual void updateScreen();
+	virtual void updateScreenRects(const Common::Rect *rects, uint numRects);
+
+	virtual uint32 getMillis();
+	virtual void delayMillis(uint msecs);
+	virtual uint32 getMicros();
+	virtual void delayMicros(uint usecs);
+	virtual void getTimeAndDate(TimeDate &t) const;
+
+	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+private:
+	/** Advance the virtual clock, firing the timers and mixing the sound due. */
+	void advance(uint64 usecs);
+	void runBackground();
+	void mixAudio();
+	void logFrame();
+
+	static uint64 getRealMicros();
+
+	enum {
+		kSampleRate = 22050,
+		kMixChunk = 1024
+	};
+
+	uint64 _clock;
+	uint64 _lastMixClock;
+	uint64 _pendingSamples;
+	bool _inBackground;
+	byte _mixBuffer[kMixChunk * 4];
+
+	uint32 _frameCount;
+	uint32 _maxFrames;
+	bool _quitSent;
+	bool _hashFrames;
+	uint64 _lastFrameTime;
+	Common::DumpFile _frameLog;
+};
+
+OSystem_NULL::OSystem_NULL() :
+	_clock(0),
+	_lastMixClock(0),
+	_pendingSamples(0),
+	_inBackground(false),
+	_frameCount(0),
+	_maxFrames(0),
+	_quitSent(false),
+	_hashFrames(false),
+	_lastFrameTime(0) {
+#if defined(POSIX)
+	_fsFactory = new POSIXFilesystemFactory();
+#endif
+}
+
+OSystem_NULL::~OSystem_NULL() {
+	_frameLog.close();
+
+	// Some managers still need the system while being destroyed, which
+	// the base class destructors would be too late for
+	delete _savefileManager;
+	_savefileManager = 0;
+	delete _eventManager;
+	_eventManager = 0;
+	delete _audiocdManager;
+	_audiocdManager = 0;
+	delete _mixer;
+	_mixer = 0;
+	delete _timerManager;
+	_timerManager = 0;
+	delete _graphicsManager;
+	_graphicsManager = 0;
+	delete _mutexManager;
+	_mutexManager = 0;
+}
+
+void OSystem_NULL::initBackend() {
+	_mutexManager = new NullMutexManager();
+	_timerManager = new DefaultTimerManager();
+	_eventManager = new DefaultEventManager(this);
+#if defined(POSIX)
+	_savefileManager = new POSIXSaveFileManager();
+#else
+	_savefileManager = new DefaultSaveFileManager();
+#endif
+	_graphicsManager = new NullGraphicsManager();
+
+	Audio::MixerImpl *mixer = new Audio::MixerImpl(this, kSampleRate);
+	mixer->setReady(true);
+	_mixer = mixer;
+
+	// Needs the mixer
+	_audiocdManager = new DefaultAudioCDManager();
+
+	if (ConfMan.hasKey("headless_frames"))
+		_maxFrames = ConfMan.getInt("headless_frames");
+	if (ConfMan.hasKey("headless_frame_hash"))
+		_hashFrames = ConfMan.getBool("headless_frame_hash");
+	if (ConfMan.hasKey("headless_frame_log")) {
+		const Common::String &path = ConfMan.get("headless_frame_log");
+		if (!_frameLog.open(path))
+			warning("Could not open the frame log '%s'", path.c_str());
+	}
+	_lastFrameTime = getRealMicros();
+
+	ModularBackend::initBackend();
+}
+
+bool OSystem_NULL::pollEvent(Common::Event &event) {
+	runBackground();
+
+	if (_maxFrames && _frameCount >= _maxFrames && !_quitSent) {
+		_quitSent = true;
+		event.type = Common::EVENT_QUIT;
+		return true;
+	}
+	return false;
+}
+
+void OSystem_NULL::updateScreen() {
+	ModularBackend::updateScreen();
+	logFrame();
+}
+
+void OSystem_NULL::updateScreenRects(const Common::Rect *rects, uint numRects) {
+	ModularBackend::updateScreenRects(rects, numRects);
+	logFrame();
+}
+
+uint32 OSystem_NULL::getMillis() {
+	// Every query takes a little time, so that busy waits end
+	uint32 millis = (uint32)(++_clock / 1000);
+	g_eventRec.processMillis(millis);
+	return millis;
+}
+
+void OSystem_NULL::delayMillis(uint msecs) {
+	if (!g_eventRec.processDelayMillis(msecs))
+		advance((uint64)msecs * 1000);
+}
+
+uint32 OSystem_NULL::getMicros() {
+	return (uint32)++_clock;
+}
+
+void OSystem_NULL::delayMicros(uint usecs) {
+	advance(usecs);
+}
+
+void OSystem_NULL::getTimeAndDate(TimeDate &td) const {
+	time_t curTime = time(0);
+	struct tm t = *localtime(&curTime);
+	td.tm_sec = t.tm_sec;
+	td.tm_min = t.tm_min;
+	td.tm_hour = t.tm_hour;
+	td.tm_mday = t.tm_mday;
+	td.tm_mon = t.tm_mon;
+	td.tm_year = t.tm_year;
+}
+
+void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
+	FILE *output = (type == LogMessageType::kInfo || type == LogMessageType::kDebug) ? stdout : stderr;
+	fputs(message, output);
+	fflush(output);
+}
+
+void OSystem_NULL::advance(uint64 usecs) {
+	_clock += usecs;
+	runBackground();
+}
+
+void OSystem_NULL::runBackground() {
+	// Timer procedures may poll the clock themselves; don't recurse
+	if (_inBackground)
+		return;
+	_inBackground = true;
+	if (_timerManager)
+		((DefaultTimerManager *)_timerManager)->handler();
+	mixAudio();
+	_inBackground = false;
+}
+
+void OSystem_NULL::mixAudio() {
+	if (!_mixer)
+		return;
+
+	// Mix as many samples as the sound card would have played since the
+	// last time, keeping the remainder so that no drift builds up
+	_pendingSamples += (_clock - _lastMixClock) * kSampleRate;
+	_lastMixClock = _clock;
+
+	uint samples = (uint)(_pendingSamples / 1000000);
+	_pendingSamples -= (uint64)samples * 1000000;
+
+	Audio::MixerImpl *mixer = (Audio::MixerImpl *)_mixer;
+	while (samples > 0) {
+		uint chunk = MIN<uint>(samples, kMixChunk);
+		// The mixer always produces 16 bit stereo
+		mixer->mixCallback(_mixBuffer, chunk * 4);
+		samples -= chunk;
+	}
+}
+
+void OSystem_NULL::logFrame() {
+	++_frameCount;
+	if (!_frameLog.isOpen())
+		return;
+
+	uint64 now = getRealMicros();
+	uint32 elapsed = (uint32)(now - _lastFrameTime);
+	_lastFrameTime = now;
+
+	uint32 hash = 0;
+	if (_hashFrames) {
+		// FNV-1a over the visible pixels
+		const Graphics::Surface &screen = ((NullGraphicsManager *)_graphicsManager)->getScreen();
+		hash = 2166136261u;
+		for (int y = 0; y < screen.h; ++y) {
+			const byte *row = (const byte *)screen.getBasePtr(0, y);
+			for (int i = 0; i < screen.w * screen.format.bytesPerPixel; ++i)
+				hash = (hash ^ row[i]) * 16777619u;
+		}
+	}
+
+	_frameLog.writeString(Common::String::format("%u %u %08x\n", _frameCount, elapsed, hash));
+}
+
+uint64 OSystem_NULL::getRealMicros() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+int main(int argc, char *argv[]) {
+	g_system = new OSystem_NULL();
+	assert(g_system);
+
+	// Invoke the actual ScummVM main entry point:
+	int res = scummvm_main(argc, argv);
+
+	delete (OSystem_NULL *)g_system;
+
+	return res;
+}
+
+#endif
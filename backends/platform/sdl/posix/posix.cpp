@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -73,6 +74,18 @@ void OSystem_POSIX::initBackend() {
 #endif
 }
 
+uint32 OSystem_POSIX::getMicros() {
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+
+	// Wrapping around is fine, only differences matter
+	return (uint32)curTime.tv_sec * 1000000 + (uint32)curTime.tv_usec;
+}
+
+void OSystem_POSIX::delayMicros(uint usecs) {
+	usleep(usecs);
+}
+
 bool OSystem_POSIX::hasFeature(Feature f) {
 	if (f == kFeatureDisplayLogFile)
 		return true;
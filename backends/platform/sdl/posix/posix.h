@@ -38,6 +38,9 @@ public:
 	virtual void init();
 	virtual void initBackend();
 
+	virtual uint32 getMicros();
+	virtual void delayMicros(uint usecs);
+
 protected:
 	/**
 	 * Base string for creating the default path and filename for the
@@ -84,6 +84,16 @@ void OSystem_Win32::initBackend() {
 }
 
 
+uint32 OSystem_Win32::getMicros() {
+	LARGE_INTEGER frequency, counter;
+	if (!QueryPerformanceFrequency(&frequency) || !QueryPerformanceCounter(&counter))
+		return OSystem_SDL::getMicros();
+
+	// Split the computation to avoid overflowing the 64 bit counter
+	return (uint32)((counter.QuadPart / frequency.QuadPart) * 1000000 +
+	                (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart);
+}
+
 bool OSystem_Win32::hasFeature(Feature f) {
 	if (f == kFeatureDisplayLogFile)
 		return true;
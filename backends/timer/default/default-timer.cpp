@@ -30,81 +30,158 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint32 nextFireTime;	// in microseconds
+	int lane;
+	bool removed;	// removed while its callback was running
 
-	TimerSlot *next;
+	// Statistics, times in microseconds
+	uint32 calls;
+	uint32 overruns;
+	uint32 maxLateness;
+	double totalLateness;
+	uint32 maxDuration;
+	double totalDuration;
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+// The clock wraps around, so compare the times by their difference
+static inline bool firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	return (int32)(a->nextFireTime - b->nextFireTime) < 0;
+}
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
+static void siftUp(Common::Array<TimerSlot *> &queue, uint pos) {
+	while (pos > 0) {
+		uint parent = (pos - 1) / 2;
+		if (!firesBefore(queue[pos], queue[parent]))
+			break;
+		SWAP(queue[pos], queue[parent]);
+		pos = parent;
+	}
+}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
+static void siftDown(Common::Array<TimerSlot *> &queue, uint pos) {
+	const uint size = queue.size();
 	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+		uint first = pos;
+		uint left = pos * 2 + 1;
+		uint right = left + 1;
+		if (left < size && firesBefore(queue[left], queue[first]))
+			first = left;
+		if (right < size && firesBefore(queue[right], queue[first]))
+			first = right;
+		if (first == pos)
+			break;
+		SWAP(queue[pos], queue[first]);
+		pos = first;
+	}
+}
+
+static void pushSlot(Common::Array<TimerSlot *> &queue, TimerSlot *slot) {
+	queue.push_back(slot);
+	siftUp(queue, queue.size() - 1);
+}
+
+static void removeSlotAt(Common::Array<TimerSlot *> &queue, uint pos) {
+	queue[pos] = queue.back();
+	queue.pop_back();
+	if (pos < queue.size()) {
+		siftDown(queue, pos);
+		siftUp(queue, pos);
 	}
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_head(0) {
+	_nextSlowLane(1) {
 
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	for (int i = 0; i < kNumLanes; ++i)
+		_lanes[i].running = 0;
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (int i = 0; i < kNumLanes; ++i) {
+		TimerQueue &queue = _lanes[i].queue;
+		for (uint j = 0; j < queue.size(); ++j)
+			delete queue[j];
+		queue.clear();
 	}
-	_head = 0;
 }
 
 void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+	for (int i = 0; i < kNumLanes; ++i)
+		handler(i);
+}
+
+uint32 DefaultTimerManager::handler(int laneNum) {
+	Lane &lane = _lanes[laneNum];
+	Common::StackLock laneLock(lane.mutex);
+
+	// Only run the timers due when the call started: a callback taking
+	// longer than its interval would otherwise always be due again, and
+	// the lane would never return
+	const uint32 curTime = g_system->getMicros();
+
+	while (true) {
+		TimerSlot *slot;
+		uint32 fireTime;
+		{
+			Common::StackLock lock(_mutex);
 
-	const uint32 curTime = g_system->getMillis();
-
-	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
-		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+			if (lane.queue.empty())
+				return kIdleTime;
+
+			slot = lane.queue.front();
+			if ((int32)(slot->nextFireTime - curTime) > 0) {
+				// The callbacks may have taken some time since
+				int32 wait = (int32)(slot->nextFireTime - g_system->getMicros());
+				return MAX<int32>(wait, 0);
+			}
+
+			// Reschedule the slot before running it, like if it was already
+			// done. A slot falling behind runs again in this call, up to the
+			// time it started, to catch up.
+			fireTime = slot->nextFireTime;
+			slot->nextFireTime += slot->interval;
+			siftDown(lane.queue, 0);
+
+			lane.running = slot;
+			slot->calls++;
+			uint32 lateness = curTime - fireTime;
+			slot->maxLateness = MAX(slot->maxLateness, lateness);
+			slot->totalLateness += lateness;
 		}
-		insertPrioQueue(_head, slot);
 
-		// Invoke the timer callback
+		// Invoke the timer callback, letting the other lanes go on
 		assert(slot->callback);
+		const uint32 startTime = g_system->getMicros();
 		slot->callback(slot->refCon);
+		const uint32 duration = g_system->getMicros() - startTime;
+
+		Common::StackLock lock(_mutex);
+		lane.running = 0;
+		if (slot->removed) {
+			delete slot;
+			continue;
+		}
+
+		slot->maxDuration = MAX(slot->maxDuration, duration);
+		slot->totalDuration += duration;
+		if (duration > slot->interval)
+			slot->overruns++;
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+		// Keep the slow callbacks out of the way of the quick ones
+		if (laneNum == 0 && duration > kSlowCallbackTime && kNumLanes > 1) {
+			for (uint i = 0; i < lane.queue.size(); ++i) {
+				if (lane.queue[i] == slot) {
+					removeSlotAt(lane.queue, i);
+					break;
+				}
+			}
+			slot->lane = _nextSlowLane;
+			pushSlot(_lanes[slot->lane].queue, slot);
+			_nextSlowLane = _nextSlowLane % (kNumLanes - 1) + 1;
+		}
 	}
 }
 
@@ -131,44 +208,102 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
+	slot->nextFireTime = g_system->getMicros() + interval;
+	slot->lane = 0;
+	slot->removed = false;
+	slot->calls = 0;
+	slot->overruns = 0;
+	slot->maxLateness = 0;
+	slot->totalLateness = 0;
+	slot->maxDuration = 0;
+	slot->totalDuration = 0;
 
-	insertPrioQueue(_head, slot);
+	pushSlot(_lanes[0].queue, slot);
 
 	return true;
 }
 
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
-	Common::StackLock lock(_mutex);
+	bool waitLane[kNumLanes];
+
+	{
+		Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
+		for (int i = 0; i < kNumLanes; ++i) {
+			Lane &lane = _lanes[i];
+			waitLane[i] = false;
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
+			uint j = 0;
+			while (j < lane.queue.size()) {
+				TimerSlot *slot = lane.queue[j];
+				if (slot->callback != callback) {
+					++j;
+					continue;
+				}
+
+				removeSlotAt(lane.queue, j);
+				// A running slot is deleted by its lane, once the call is over
+				if (lane.running == slot) {
+					slot->removed = true;
+					waitLane[i] = true;
+				} else {
+					delete slot;
+				}
+			}
+		}
+
+		// We need to remove all names referencing the timer proc here.
+		//
+		// Else we run into troubles, when the client code removes and readds timer
+		// callbacks.
+		//
+		// Another issues occurs when one plays a game with ALSA as music driver,
+		// does RTL and starts a different engine game with ALSA as music driver.
+		// In this case the MPU401 code will add different timer procs with the
+		// same name, resulting in two different callbacks added with the same
+		// name and causing installTimerProc to error out.
+		// A good test case is running a SCUMM with ALSA output and then a KYRA
+		// game for example.
+		for (TimerSlotMap::iterator i = _callbacks.begin(), end = _callbacks.end(); i != end; ++i) {
+			if (i->_value == callback)
+				_callbacks.erase(i);
 		}
 	}
 
-	// We need to remove all names referencing the timer proc here.
-	//
-	// Else we run into troubles, when the client code removes and readds timer
-	// callbacks.
-	//
-	// Another issues occurs when one plays a game with ALSA as music driver,
-	// does RTL and starts a different engine game with ALSA as music driver.
-	// In this case the MPU401 code will add different timer procs with the
-	// same name, resulting in two different callbacks added with the same
-	// name and causing installTimerProc to error out.
-	// A good test case is running a SCUMM with ALSA output and then a KYRA
-	// game for example.
-	for (TimerSlotMap::iterator i = _callbacks.begin(), end = _callbacks.end(); i != end; ++i) {
-		if (i->_value == callback)
-			_callbacks.erase(i);
+	// Make sure the callback doesn't run anymore when returning. When
+	// called from the callback itself, the lane's lock is already ours.
+	for (int i = 0; i < kNumLanes; ++i) {
+		if (waitLane[i]) {
+			_lanes[i].mutex.lock();
+			_lanes[i].mutex.unlock();
+		}
 	}
 }
+
+TimerSlot *DefaultTimerManager::findSlot(const Common::String &id) {
+	for (int i = 0; i < kNumLanes; ++i) {
+		const TimerQueue &queue = _lanes[i].queue;
+		for (uint j = 0; j < queue.size(); ++j) {
+			if (queue[j]->id.equalsIgnoreCase(id))
+				return queue[j];
+		}
+	}
+	return 0;
+}
+
+bool DefaultTimerManager::getTimerStats(const Common::String &id, TimerStats &stats) {
+	Common::StackLock lock(_mutex);
+
+	const TimerSlot *slot = findSlot(id);
+	if (!slot)
+		return false;
+
+	stats.calls = slot->calls;
+	stats.overruns = slot->overruns;
+	stats.maxLateness = slot->maxLateness;
+	stats.meanLateness = slot->calls ? (uint32)(slot->totalLateness / slot->calls) : 0;
+	stats.maxDuration = slot->maxDuration;
+	stats.meanDuration = slot->calls ? (uint32)(slot->totalDuration / slot->calls) : 0;
+	stats.lane = slot->lane;
+	return true;
+}
@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -29,24 +30,67 @@
 
 struct TimerSlot;
 
+/**
+ * Timer manager keeping microsecond deadlines.
+ *
+ * The timers are spread over a few execution lanes, each with its own
+ * queue and lock, so that the backend can run every lane from a thread
+ * of its own. A timer starts in the first lane; once one of its calls
+ * takes longer than kSlowCallbackTime, it is moved to one of the other
+ * lanes, so that a callback decoding a video frame can't delay the ones
+ * which only need a few microseconds, like the music fades.
+ */
 class DefaultTimerManager : public Common::TimerManager {
+public:
+	enum {
+		kNumLanes = 3,
+		/** Calls taking longer than this move a timer out of the first lane, in microseconds */
+		kSlowCallbackTime = 2000,
+		/** Returned by handler() when the lane has no timer, in microseconds */
+		kIdleTime = 10000
+	};
+
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
+	typedef Common::Array<TimerSlot *> TimerQueue;
+
+	struct Lane {
+		/** Held while the lane runs its callbacks */
+		Common::Mutex mutex;
+		/** Binary heap, ordered by the next fire time */
+		TimerQueue queue;
+		/** The slot whose callback is running, if any */
+		TimerSlot *running;
+	};
 
+	/** Protects the queues, the slots and the callback names */
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	Lane _lanes[kNumLanes];
+	int _nextSlowLane;
 	TimerSlotMap _callbacks;
 
+	TimerSlot *findSlot(const Common::String &id);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual bool getTimerStats(const Common::String &id, TimerStats &stats);
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
+	 * Runs the due timers of all the lanes, one lane after the other.
 	 */
 	void handler();
+
+	/**
+	 * Run the due timers of one lane. Different lanes may be run at the
+	 * same time from different threads.
+	 *
+	 * @return the number of microseconds until the next timer of the lane is due
+	 */
+	uint32 handler(int lane);
 };
 
 #endif
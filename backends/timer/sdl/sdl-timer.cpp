@@ -28,25 +28,43 @@
 #include "backends/timer/sdl/sdl-timer.h"
 
 #include "common/textconsole.h"
+#include "common/util.h"
 
-static Uint32 timer_handler(Uint32 interval, void *param) {
-	((DefaultTimerManager *)param)->handler();
-	return interval;
+int SdlTimerManager::laneThread(void *param) {
+	LaneThread *lane = (LaneThread *)param;
+
+	while (!lane->manager->_quit) {
+		uint32 wait = lane->manager->handler(lane->lane);
+
+		// SDL_Delay has a resolution of a millisecond. Don't sleep too
+		// long either, so that new timers start on time.
+		SDL_Delay(CLIP<uint32>(wait / 1000, 1, kIdleTime / 1000));
+	}
+	return 0;
 }
 
-SdlTimerManager::SdlTimerManager() {
+SdlTimerManager::SdlTimerManager() :
+	_quit(false) {
 	// Initializes the SDL timer subsystem
 	if (SDL_InitSubSystem(SDL_INIT_TIMER) == -1) {
 		error("Could not initialize SDL: %s", SDL_GetError());
 	}
 
-	// Creates the timer callback
-	_timerID = SDL_AddTimer(10, &timer_handler, this);
+	// Creates the timer threads
+	for (int i = 0; i < kNumLanes; ++i) {
+		_threads[i].manager = this;
+		_threads[i].lane = i;
+		_threads[i].thread = SDL_CreateThread(&laneThread, &_threads[i]);
+		if (!_threads[i].thread)
+			error("Could not create timer thread: %s", SDL_GetError());
+	}
 }
 
 SdlTimerManager::~SdlTimerManager() {
-	// Removes the timer callback
-	SDL_RemoveTimer(_timerID);
+	// Stops the timer threads
+	_quit = true;
+	for (int i = 0; i < kNumLanes; ++i)
+		SDL_WaitThread(_threads[i].thread, NULL);
 }
 
 #endif
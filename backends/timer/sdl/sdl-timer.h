@@ -28,8 +28,8 @@
 #include "backends/platform/sdl/sdl-sys.h"
 
 /**
- * SDL timer manager. Setups the timer callback for
- * DefaultTimerManager.
+ * SDL timer manager. Runs every lane of DefaultTimerManager in a thread
+ * of its own, which sleeps until the next timer of the lane is due.
  */
 class SdlTimerManager : public DefaultTimerManager {
 public:
@@ -37,7 +37,16 @@ public:
 	virtual ~SdlTimerManager();
 
 protected:
-	SDL_TimerID _timerID;
+	struct LaneThread {
+		SdlTimerManager *manager;
+		int lane;
+		SDL_Thread *thread;
+	};
+
+	static int laneThread(void *param);
+
+	LaneThread _threads[kNumLanes];
+	volatile bool _quit;
 };
 
 
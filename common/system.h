@@ -763,6 +763,20 @@ public:
 	 */
 	virtual void updateScreen() = 0;
 
+	/**
+	 * Flush only the given parts of the screen framebuffer to the display,
+	 * the rest of the framebuffer must not have changed since it was last
+	 * flushed.
+	 * !!! ResidualVM specific method !!!
+	 *
+	 * The default implementation flushes the whole screen.
+	 *
+	 * @param rects		the rectangles to flush
+	 * @param numRects	the number of rectangles
+	 * @see updateScreen
+	 */
+	virtual void updateScreenRects(const Common::Rect *rects, uint numRects) { updateScreen(); }
+
 	/**
 	 * !!! Not used in ResidualVM !!!
 	 *
@@ -971,6 +985,22 @@ public:
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
+	/**
+	 * Get the number of microseconds since the program was started.
+	 * The value wraps around after about 71 minutes, so only the difference
+	 * between two values is meaningful.
+	 *
+	 * The default implementation only has the resolution of getMillis().
+	 */
+	virtual uint32 getMicros() { return getMillis() * 1000; }
+
+	/**
+	 * Delay/sleep for the specified amount of microseconds.
+	 *
+	 * The default implementation only has the resolution of delayMillis().
+	 */
+	virtual void delayMicros(uint usecs) { delayMillis(usecs / 1000); }
+
 	/**
 	 * Get the current time and date, in the local timezone.
 	 * Corresponds on many systems to the combination of time()
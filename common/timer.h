@@ -32,6 +32,17 @@ class TimerManager : NonCopyable {
 public:
 	typedef void (*TimerProc)(void *refCon);
 
+	/** How well an installed timer keeps up, with the times in microseconds. */
+	struct TimerStats {
+		uint32 calls;           ///< Number of times the callback was invoked
+		uint32 overruns;        ///< Calls which took longer than the interval
+		uint32 maxLateness;     ///< Largest delay between the due time and the call
+		uint32 meanLateness;
+		uint32 maxDuration;     ///< Longest time spent in the callback
+		uint32 meanDuration;
+		int lane;               ///< Execution lane of the timer, for backends having several
+	};
+
 	virtual ~TimerManager() {}
 
 	/**
@@ -40,7 +51,7 @@ public:
 	 * written following the same safety guidelines as any other threaded code.
 	 *
 	 * @note Although the interval is specified in microseconds, the actual timer resolution
-	 *       may be lower. In particular, with the SDL backend the timer resolution is 10ms.
+	 *       may be lower. In particular, with the SDL backend the timer resolution is 1ms.
 	 * @param proc		the callback
 	 * @param interval	the interval in which the timer shall be invoked (in microseconds)
 	 * @param refCon	an arbitrary void pointer; will be passed to the timer callback
@@ -54,6 +65,15 @@ public:
 	 * and no instance of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Get the timing statistics of an installed timer.
+	 *
+	 * @param id		the id the timer was installed with
+	 * @param stats		filled in with the statistics
+	 * @return	false if there is no such timer, or the backend doesn't keep statistics
+	 */
+	virtual bool getTimerStats(const Common::String &id, TimerStats &stats) { return false; }
 };
 
 } // End of namespace Common
@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -147,7 +148,9 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		CHECKPOINT_INTERVAL = 1024 * 1024,
+		MAX_CHECKPOINTS = 64
 	};
 
 	byte	_buf[BUFSIZE];
@@ -159,9 +162,62 @@ protected:
 	uint32 _origSize;
 	bool _eos;
 
+	/**
+	 * A copy of the decompressor state at some position of the output, so
+	 * that seeking backward doesn't need to restart from the start of the
+	 * file. They are taken the first time the data is read, every
+	 * _checkpointInterval bytes. When there are too many of them, every
+	 * other one is dropped and the interval doubled.
+	 */
+	struct Checkpoint {
+		uint32 pos;
+		int32 wrappedPos;
+		z_stream *state;
+	};
+	Array<Checkpoint> _checkpoints;
+	uint32 _checkpointInterval;
+
+	void addCheckpoint(uint32 pos) {
+		Checkpoint checkpoint;
+		checkpoint.pos = pos;
+		checkpoint.wrappedPos = _wrapped->pos() - _stream.avail_in;
+		checkpoint.state = new z_stream;
+		if (inflateCopy(checkpoint.state, &_stream) != Z_OK) {
+			delete checkpoint.state;
+			return;
+		}
+		_checkpoints.push_back(checkpoint);
+
+		if (_checkpoints.size() >= MAX_CHECKPOINTS) {
+			uint j = 0;
+			for (uint i = 0; i < _checkpoints.size(); ++i) {
+				if (i % 2 == 0) {
+					inflateEnd(_checkpoints[i].state);
+					delete _checkpoints[i].state;
+				} else {
+					_checkpoints[j++] = _checkpoints[i];
+				}
+			}
+			_checkpoints.resize(j);
+			_checkpointInterval *= 2;
+		}
+	}
+
+	bool restoreCheckpoint(const Checkpoint &checkpoint) {
+		inflateEnd(&_stream);
+		_zlibErr = inflateCopy(&_stream, checkpoint.state);
+		if (_zlibErr != Z_OK)
+			return false;
+		_wrapped->seek(checkpoint.wrappedPos, SEEK_SET);
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = checkpoint.pos;
+		return true;
+	}
+
 public:
 
-	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream() {
+	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream(), _checkpointInterval(CHECKPOINT_INTERVAL) {
 		assert(w != 0);
 
 		// Verify file header is correct
@@ -199,6 +255,10 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+		for (uint i = 0; i < _checkpoints.size(); ++i) {
+			inflateEnd(_checkpoints[i].state);
+			delete _checkpoints[i].state;
+		}
 	}
 
 	bool err() const { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -213,6 +273,11 @@ public:
 
 		// Keep going while we get no error
 		while (_zlibErr == Z_OK && _stream.avail_out) {
+			uint32 outPos = _pos + dataSize - _stream.avail_out;
+			uint32 lastCheckpoint = _checkpoints.empty() ? 0 : _checkpoints.back().pos;
+			if (outPos >= lastCheckpoint + _checkpointInterval)
+				addCheckpoint(outPos);
+
 			if (_stream.avail_in == 0 && !_wrapped->eos()) {
 				// If we are out of input data: Read more data, if available.
 				_stream.next_in = _buf;
@@ -252,10 +317,17 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
-			// To search backward, we have to restart the whole decompression
-			// from the start of the file. A rather wasteful operation, best
-			// to avoid it. :/
+		// Continue from the last checkpoint before the new position, if
+		// that is closer than the current one
+		int checkpoint = -1;
+		for (uint i = 0; i < _checkpoints.size() && _checkpoints[i].pos <= (uint32)newPos; ++i)
+			checkpoint = i;
+		if (checkpoint >= 0 && (_checkpoints[checkpoint].pos > _pos || (uint32)newPos < _pos)) {
+			if (!restoreCheckpoint(_checkpoints[checkpoint]))
+				return false;	// FIXME: STREAM REWRITE
+		} else if ((uint32)newPos < _pos) {
+			// To search backward before the first checkpoint, we have to
+			// restart the whole decompression from the start of the file.
 #if DEBUG
 			warning("Backward seeking in GZipReadStream detected");
 #endif
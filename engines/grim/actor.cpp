@@ -1292,7 +1292,9 @@ void Actor::update(uint frameTime) {
 			costumeMarkerCallback(marker);
 		}
 	}
+}
 
+void Actor::animate() {
 	for (Common::List<Costume *>::iterator i = _costumeStack.begin(); i != _costumeStack.end(); ++i) {
 		Costume *c = *i;
 		c->animate();
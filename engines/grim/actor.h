@@ -435,7 +435,18 @@ public:
 	void setConstrain(bool constrain) {
 		_constrain = constrain;
 	}
+	/**
+	 * Update the movement, the chores and the lip syncing of the actor.
+	 * This may call back into Lua and affect other actors, and so must
+	 * be done for all of them before any is animated.
+	 */
 	void update(uint frameTime);
+	/**
+	 * Pose the costumes of the actor after update(). This only touches the
+	 * actor's own costumes, so the order in which actors are animated
+	 * doesn't matter.
+	 */
+	void animate();
 	/**
 	 * Check if the actor is still talking. If it is returns true, otherwise false.
 	 */
@@ -36,6 +36,12 @@ namespace Grim {
 static bool decompress_codec3(const char *compressed, char *result, int maxBytes);
 
 Common::HashMap<Common::String, BitmapData *> *BitmapData::_bitmaps = NULL;
+uint32 BitmapData::_imageClock = 0;
+uint32 BitmapData::_frameStart = 1;
+uint32 BitmapData::_decodedBytes = 0;
+
+// How much memory the images of lazily decoded bitmaps may take at the same time
+static const uint32 kMaxDecodedBytes = 16 * 1024 * 1024;
 
 BitmapData *BitmapData::getBitmapData(const Common::String &fname) {
 	Common::String str(fname);
@@ -59,6 +65,10 @@ BitmapData::BitmapData(const Common::String &fname) {
 	_data = 0;
 	_loaded = false;
 	_keepData = true;
+	_released = false;
+	_codec = 0;
+	_imageOffsets = NULL;
+	_imageStamps = NULL;
 }
 
 void BitmapData::load() {
@@ -104,42 +114,34 @@ bool BitmapData::loadGrimBm(Common::SeekableReadStream *data) {
 // 	uint32 greenShift = data->readUint32LE();
 // 	uint32 blueShift = data->readUint32LE();
 
-	// Hardcode the format, since the values saved in the files are garbage for some, like "ha_0_elvos.zbm".
-	Graphics::PixelFormat pixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
-
 	data->seek(128, SEEK_SET);
 	_width = data->readUint32LE();
 	_height = data->readUint32LE();
 	_colorFormat = BM_RGB565;
 	_hasTransparency = false;
 
+	// Only remember where the images are, they are decoded when they are first
+	// needed. The first one is the default active image, so decode it right away.
+	_codec = codec;
 	_data = new Graphics::PixelBuffer[_numImages];
+	_imageOffsets = new uint32[_numImages];
+	_imageStamps = new uint32[_numImages];
 	data->seek(0x80, SEEK_SET);
 	for (int i = 0; i < _numImages; i++) {
 		data->seek(8, SEEK_CUR);
-		_data[i].create(pixelFormat, _width * _height, DisposeAfterUse::YES);
+		_imageOffsets[i] = data->pos();
+		_imageStamps[i] = 0;
 		if (codec == 0) {
-			uint32 dsize = _bpp / 8 * _width * _height;
-			data->read(_data[i].getRawBuffer(), dsize);
+			data->seek(_bpp / 8 * _width * _height, SEEK_CUR);
 		} else if (codec == 3) {
 			int compressed_len = data->readUint32LE();
-			char *compressed = new char[compressed_len];
-			data->read(compressed, compressed_len);
-			bool success = decompress_codec3(compressed, (char *)_data[i].getRawBuffer(), _bpp / 8 * _width * _height);
-			delete[] compressed;
-			if (!success)
-				warning(".. when loading image %s.\n", _fname.c_str());
+			data->seek(compressed_len, SEEK_CUR);
 		} else
 			Debug::error(Debug::Bitmaps, "Unknown image codec in BitmapData ctor!");
-
-#ifdef SCUMM_BIG_ENDIAN
-		if (_format == 1) {
-			uint16 *d = (uint16 *)_data[i].getRawBuffer();
-			for (int j = 0; j < _width * _height; ++j) {
-				d[j] = SWAP_BYTES_16(d[j]);
-			}
-		}
-#endif
+	}
+	if (_numImages > 0) {
+		evictImages(getDecodedImageSize());
+		decodeImage(0, data);
 	}
 
 	// Initially, no GPU-side textures created. the createBitmap
@@ -151,9 +153,115 @@ bool BitmapData::loadGrimBm(Common::SeekableReadStream *data) {
 	return true;
 }
 
+void BitmapData::decodeImage(int num, Common::SeekableReadStream *data) {
+	// Hardcode the format, since the values saved in the files are garbage for some, like "ha_0_elvos.zbm".
+	Graphics::PixelFormat pixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+	data->seek(_imageOffsets[num], SEEK_SET);
+	_data[num].create(pixelFormat, _width * _height, DisposeAfterUse::YES);
+	if (_codec == 0) {
+		uint32 dsize = _bpp / 8 * _width * _height;
+		data->read(_data[num].getRawBuffer(), dsize);
+	} else if (_codec == 3) {
+		int compressed_len = data->readUint32LE();
+		char *compressed = new char[compressed_len];
+		data->read(compressed, compressed_len);
+		bool success = decompress_codec3(compressed, (char *)_data[num].getRawBuffer(), _bpp / 8 * _width * _height);
+		delete[] compressed;
+		if (!success)
+			warning(".. when loading image %s.\n", _fname.c_str());
+	}
+
+#ifdef SCUMM_BIG_ENDIAN
+	if (_format == 1) {
+		uint16 *d = (uint16 *)_data[num].getRawBuffer();
+		for (int j = 0; j < _width * _height; ++j) {
+			d[j] = SWAP_BYTES_16(d[j]);
+		}
+	}
+#endif
+
+	_imageStamps[num] = ++_imageClock;
+	_decodedBytes += getDecodedImageSize();
+}
+
+uint32 BitmapData::getDecodedImageSize() const {
+	// The images are always decoded to RGB565
+	return _width * _height * 2;
+}
+
+void BitmapData::prepareImage(int num) {
+	if (!_imageStamps || num < 0 || num >= _numImages)
+		return;
+
+	if (_imageStamps[num] != 0) {
+		_imageStamps[num] = ++_imageClock;
+		return;
+	}
+
+	Common::SeekableReadStream *data = g_resourceloader->openNewStreamFile(_fname.c_str());
+	if (!data) {
+		warning("Could not reopen bitmap %s to decode image %d", _fname.c_str(), num);
+		return;
+	}
+	evictImages(getDecodedImageSize());
+	decodeImage(num, data);
+	delete data;
+
+	g_driver->createBitmapImage(this, num);
+}
+
+void BitmapData::unloadImage(int num) {
+	g_driver->destroyBitmapImage(this, num);
+	_data[num].free();
+	_imageStamps[num] = 0;
+	_decodedBytes -= getDecodedImageSize();
+}
+
+void BitmapData::evictImages(uint32 needed) {
+	// The images used in this frame may still be drawn, so when they alone
+	// take more than the budget it is exceeded until the next frame.
+	while (_bitmaps && _decodedBytes + needed > kMaxDecodedBytes) {
+		BitmapData *oldest = NULL;
+		int oldestNum = 0;
+		for (Common::HashMap<Common::String, BitmapData *>::iterator it = _bitmaps->begin(); it != _bitmaps->end(); ++it) {
+			BitmapData *b = it->_value;
+			if (!b->_imageStamps || !b->_loaded)
+				continue;
+			for (int i = 0; i < b->_numImages; ++i) {
+				if (b->_imageStamps[i] != 0 && b->_imageStamps[i] < _frameStart &&
+						(!oldest || b->_imageStamps[i] < oldest->_imageStamps[oldestNum])) {
+					oldest = b;
+					oldestNum = i;
+				}
+			}
+		}
+		if (!oldest)
+			break;
+		oldest->unloadImage(oldestNum);
+	}
+}
+
+void BitmapData::freeImageCache() {
+	if (!_imageStamps)
+		return;
+
+	for (int i = 0; i < _numImages; ++i) {
+		if (_imageStamps[i] != 0)
+			_decodedBytes -= getDecodedImageSize();
+	}
+	delete[] _imageOffsets;
+	delete[] _imageStamps;
+	_imageOffsets = NULL;
+	_imageStamps = NULL;
+}
+
 BitmapData::BitmapData(const Graphics::PixelBuffer &buf, int w, int h, const char *fname) {
 	_fname = fname;
 	_refCount = 1;
+	_codec = 0;
+	_imageOffsets = NULL;
+	_imageStamps = NULL;
 	Debug::debug(Debug::Bitmaps, "New bitmap loaded: %s\n", fname);
 	_numImages = 1;
 	_x = 0;
@@ -171,13 +279,15 @@ BitmapData::BitmapData(const Graphics::PixelBuffer &buf, int w, int h, const cha
 	_data[0].copyBuffer(0, w * h, buf);
 	_loaded = true;
 	_keepData = true;
+	_released = false;
 
 	g_driver->createBitmap(this);
 }
 
 BitmapData::BitmapData() :
 	_numImages(0), _width(0), _height(0), _x(0), _y(0), _format(0), _numTex(0),
-	_bpp(0), _colorFormat(0), _texIds(0), _hasTransparency(false), _data(NULL), _refCount(1), _loaded(false) {
+	_bpp(0), _colorFormat(0), _texIds(0), _hasTransparency(false), _data(NULL), _refCount(1), _loaded(false),
+	_released(false), _codec(0), _imageOffsets(NULL), _imageStamps(NULL) {
 }
 
 BitmapData::~BitmapData() {
@@ -185,6 +295,7 @@ BitmapData::~BitmapData() {
 	if (_loaded) {
 		g_driver->destroyBitmap(this);
 	}
+	freeImageCache();
 	freeData();
 	if (_bitmaps) {
 		if (_bitmaps->contains(_fname)) {
@@ -204,6 +315,45 @@ void BitmapData::freeData() {
 	}
 }
 
+void BitmapData::releaseRenderResources() {
+	if (!_loaded || _released)
+		return;
+
+	if (_bitmaps && _bitmaps->contains(_fname)) {
+		// The renderer may have converted the data in place, so load it
+		// again from the file in restoreRenderResources().
+		g_driver->destroyBitmap(this);
+		freeImageCache();
+		delete[] _data;
+		_data = NULL;
+		_loaded = false;
+	} else {
+		Graphics::PixelBuffer *copy = new Graphics::PixelBuffer[_numImages];
+		for (int i = 0; i < _numImages; ++i) {
+			copy[i].create(_data[i].getFormat(), _width * _height, DisposeAfterUse::YES);
+			copy[i].copyBuffer(0, _width * _height, _data[i]);
+		}
+		g_driver->destroyBitmap(this);
+		delete[] _data;
+		_data = copy;
+	}
+	_texIds = NULL;
+	_numTex = 0;
+	_released = true;
+}
+
+void BitmapData::restoreRenderResources() {
+	if (!_released)
+		return;
+
+	_released = false;
+	if (_loaded) {
+		g_driver->createBitmap(this);
+	} else {
+		load();
+	}
+}
+
 bool BitmapData::loadTGA(Common::SeekableReadStream *data) {
 	data->seek(0, SEEK_SET);
 	if (data->readByte() != 0)	// Verify that description-field is empty
@@ -357,15 +507,18 @@ const Graphics::PixelBuffer &BitmapData::getImageData(int num) const {
 Bitmap::Bitmap(const Common::String &fname) {
 	_data = BitmapData::getBitmapData(fname);
 	_currImage = 1;
+	_saveGeneration = 1;
 }
 
 Bitmap::Bitmap(const Graphics::PixelBuffer &buf, int w, int h, const char *fname) {
 	_data = new BitmapData(buf, w, h, fname);
 	_currImage = 1;
+	_saveGeneration = 1;
 }
 
 Bitmap::Bitmap() {
 	_data = new BitmapData();
+	_saveGeneration = 1;
 }
 
 Bitmap *Bitmap::create(const Common::String &filename) {
@@ -390,12 +543,14 @@ void Bitmap::restoreState(SaveGame *state) {
 	_data = BitmapData::getBitmapData(fname);
 
 	_currImage = state->readLESint32();
+	++_saveGeneration;
 }
 
 void Bitmap::draw() {
 	_data->load();
 	if (_currImage == 0)
 		return;
+	_data->prepareImage(_currImage - 1);
 
 	g_driver->drawBitmap(this, _data->_x, _data->_y);
 }
@@ -404,6 +559,7 @@ void Bitmap::draw(int x, int y) {
 	_data->load();
 	if (_currImage == 0)
 		return;
+	_data->prepareImage(_currImage - 1);
 
 	g_driver->drawBitmap(this, x, y);
 }
@@ -412,6 +568,7 @@ void Bitmap::drawForeground() {
 	_data->load();
 	if (_currImage == 0)
 		return;
+	_data->prepareImage(_currImage - 1);
 
 	g_driver->drawBitmap(this, _data->_x, _data->_y, false);
 }
@@ -421,8 +578,9 @@ void Bitmap::setActiveImage(int n) {
 	_data->load();
 	if ((n - 1) >= _data->_numImages) {
 		warning("Bitmap::setActiveImage: no anim image: %d. (%s)", n, _data->_fname.c_str());
-	} else {
+	} else if (_currImage != n) {
 		_currImage = n;
+		++_saveGeneration;
 	}
 }
 
@@ -453,21 +611,15 @@ void BitmapData::convertToColorFormat(int num, const Graphics::PixelFormat &form
 	}
 
 	Graphics::PixelBuffer dst(format, _width * _height, DisposeAfterUse::NO);
-
-	for (int i = 0; i < _width * _height; ++i) {
-		if (_data[num].getValueAt(i) == 0xf81f) { //transparency
-			dst.setPixelAt(i, 0xf81f);
-		} else {
-			dst.setPixelAt(i, _data[num]);
-		}
-	}
+	dst.copyBufferKeyed(0, 0, _width * _height, _data[num], 0xf81f); //transparency
 	_data[num].free();
 	_data[num] = dst;
 }
 
 void BitmapData::convertToColorFormat(const Graphics::PixelFormat &format) {
 	for (int i = 0; i < _numImages; ++i) {
-		convertToColorFormat(i, format);
+		if (hasImageData(i))
+			convertToColorFormat(i, format);
 	}
 }
 
@@ -59,6 +59,23 @@ public:
 
 	void load();
 
+	/**
+	 * Release the renderer-side representation of the bitmap, so that the
+	 * renderer can be replaced. Bitmaps loaded from a file drop their data and
+	 * are loaded again by restoreRenderResources(), the others keep a copy
+	 * of their pixels.
+	 *
+	 * @see restoreRenderResources
+	 */
+	void releaseRenderResources();
+	/**
+	 * Recreate the renderer-side representation of the bitmap with the
+	 * current renderer.
+	 *
+	 * @see releaseRenderResources
+	 */
+	void restoreRenderResources();
+
 	/**
 	 * Loads an EMI TILE-bitmap.
 	 *
@@ -74,6 +91,26 @@ public:
 
 	const Graphics::PixelBuffer &getImageData(int num) const;
 
+	/**
+	 * Make sure that an image is decoded and handed to the renderer.
+	 * The images of Grim bitmaps are only decoded when they are first
+	 * needed, and the least recently used ones are unloaded again when
+	 * the decoded images take more than kMaxDecodedBytes. Images used in
+	 * the current frame are never unloaded.
+	 *
+	 * @param num	the zero-based index of the image.
+	 */
+	void prepareImage(int num);
+	/**
+	 * Mark the start of a new frame, after which the images used in the
+	 * previous ones may be unloaded again.
+	 */
+	static void startFrame() { _frameStart = _imageClock + 1; }
+	/**
+	 * Returns whether the pixels of an image are currently available.
+	 */
+	bool hasImageData(int num) const { return !_imageStamps || _imageStamps[num] != 0; }
+
 	/**
 	 * Convert a bitmap to another color-format.
 	 *
@@ -99,6 +136,7 @@ public:
 	bool _hasTransparency;
 	bool _loaded;
 	bool _keepData;
+	bool _released;
 
 	int _refCount;
 
@@ -120,7 +158,23 @@ public:
 	uint32 _numLayers;
 
 // private:
+	void decodeImage(int num, Common::SeekableReadStream *data);
+	void unloadImage(int num);
+	void freeImageCache();
+	uint32 getDecodedImageSize() const;
+	static void evictImages(uint32 needed);
+
 	Graphics::PixelBuffer *_data;
+
+	// Lazily decoded Grim bitmaps keep where every image is stored in the
+	// file, and when it was last used. A stamp of 0 means not decoded.
+	int _codec;
+	uint32 *_imageOffsets;
+	uint32 *_imageStamps;
+
+	static uint32 _imageClock;
+	static uint32 _frameStart;
+	static uint32 _decodedBytes;
 };
 
 class Bitmap : public PoolObject<Bitmap> {
@@ -169,6 +223,7 @@ public:
 
 	void saveState(SaveGame *state) const;
 	void restoreState(SaveGame *state);
+	uint32 getSaveGeneration() const { return _saveGeneration; }
 
 	virtual ~Bitmap();
 
@@ -181,6 +236,8 @@ public:
 	 * _currImage==0 means a null image is chosen.
 	 */
 	int _currImage;
+
+	uint32 _saveGeneration;
 };
 
 } // end of namespace Grim
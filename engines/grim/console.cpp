@@ -0,0 +1,98 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/file.h"
+
+#include "engines/grim/console.h"
+#include "engines/grim/gfx_base.h"
+#include "engines/grim/grim.h"
+#include "engines/grim/lua/lmem.h"
+#include "engines/grim/lua/lua.h"
+
+namespace Grim {
+
+Console::Console(GrimEngine *vm) : GUI::Debugger(), _vm(vm) {
+	DCmd_Register("frameStats",			WRAP_METHOD(Console, Cmd_FrameStats));
+	DCmd_Register("dumpFrameStats",		WRAP_METHOD(Console, Cmd_DumpFrameStats));
+	DCmd_Register("gcStats",			WRAP_METHOD(Console, Cmd_GCStats));
+	DCmd_Register("renderStats",		WRAP_METHOD(Console, Cmd_RenderStats));
+}
+
+Console::~Console() {
+}
+
+bool Console::Cmd_FrameStats(int argc, const char **argv) {
+	DebugPrintf("%s", _vm->getFramePacer().getStatistics().c_str());
+	return true;
+}
+
+bool Console::Cmd_DumpFrameStats(int argc, const char **argv) {
+	if (argc != 2) {
+		DebugPrintf("Dump the timings of the last frames to a CSV file.\n");
+		DebugPrintf("Usage: %s <file name>\n", argv[0]);
+		return true;
+	}
+
+	Common::DumpFile file;
+	if (!file.open(argv[1])) {
+		DebugPrintf("Can't open file '%s'\n", argv[1]);
+		return true;
+	}
+
+	_vm->getFramePacer().dumpCSV(&file);
+	file.close();
+	DebugPrintf("Frame timings written to '%s'\n", argv[1]);
+
+	return true;
+}
+
+bool Console::Cmd_GCStats(int argc, const char **argv) {
+	const lua_GCStats *stats = lua_getgcstats();
+	uint32 pauses = stats->steps + stats->fullCollections;
+
+	DebugPrintf("Lua GC: %d cycles, %d full collections, %d pauses\n", stats->cycles, stats->fullCollections, pauses);
+	DebugPrintf("Pause (us): last %d, max %d, avg %d\n", stats->lastPause, stats->maxPause, pauses ? stats->totalPause / pauses : 0);
+	DebugPrintf("Blocks: %d, threshold %d\n", stats->blocks, stats->threshold);
+
+	DebugPrintf("Live memory by size class:\n");
+	for (int i = 0; i < NUM_SIZECLASSES; i++) {
+		int32 maxSize, blocks, bytes;
+		luaM_getstats(i, &maxSize, &blocks, &bytes);
+		if (i == NUM_SIZECLASSES - 1)
+			DebugPrintf("  large: %d blocks, %d bytes\n", blocks, bytes);
+		else if (blocks)
+			DebugPrintf("  <= %d: %d blocks, %d bytes\n", maxSize, blocks, bytes);
+	}
+	return true;
+}
+
+bool Console::Cmd_RenderStats(int argc, const char **argv) {
+	const GfxBase::RenderStats &stats = g_driver->getRenderStats();
+
+	DebugPrintf("%s, last frame:\n", g_driver->getVideoDeviceName());
+	DebugPrintf("Draw calls: %d\n", stats.drawCalls);
+	DebugPrintf("State changes: %d\n", stats.stateChanges);
+	DebugPrintf("Model faces: %d\n", stats.faces);
+	return true;
+}
+
+} // end of namespace Grim
@@ -44,27 +44,27 @@ void Head::Joint::orientTowards(bool entering, const Math::Vector3d &point, floa
 	if (!_node)
 		return;
 
-	// Make sure we have up-to-date world transform matrices computed for the joint nodes of this character.
-	_node->_needsUpdate = true;
+	// Make sure we have up-to-date transform matrices computed for the joint nodes of this character.
 	ModelNode *p = _node;
-	while (p->_parent) {
+	while (p->_parent)
 		p = p->_parent;
-		p->_needsUpdate = true;
-	}
-	p->setMatrix(matrix);
 	p->update();
 
+	// The node matrices are relative to the character, bring them to world space.
+	const Math::Matrix4 nodeWorldTM = matrix * _node->_matrix;
+	const Math::Matrix4 pivotWorldTM = matrix * _node->_pivotMatrix;
+
 	Math::Vector3d modelFront; // the modeling convention for the forward direction.
 	Math::Vector3d modelUp; // the modeling convention for the upward direction.
 	Math::Vector3d frontDir; // Character front facing direction vector in world space (global scene coordinate space)
 
 	// the character head coordinate frame is: +Y forward, +Z up, +X right.
-	frontDir = Math::Vector3d(_node->_matrix(0,1), _node->_matrix(1,1), _node->_matrix(2,1)); // Look straight ahead. (+Y)
+	frontDir = Math::Vector3d(nodeWorldTM(0,1), nodeWorldTM(1,1), nodeWorldTM(2,1)); // Look straight ahead. (+Y)
 	modelFront = Math::Vector3d(0,1,0);
 	modelUp = Math::Vector3d(0,0,1);
 
 	// v is the world space direction vector this character should be looking towards.
-	Math::Vector3d targetDir = point - _node->_pivotMatrix.getPosition();
+	Math::Vector3d targetDir = point - pivotWorldTM.getPosition();
 	if (!entering)
 		targetDir = frontDir;
 	if (targetDir.isZero())
@@ -91,7 +91,7 @@ void Head::Joint::orientTowards(bool entering, const Math::Vector3d &point, floa
 	// Get the coordinate frame in which we need to produce the character head yaw/pitch/roll values.
 	Math::Matrix4 parentWorldTM;
 	if (_node->_parent)
-		parentWorldTM = _node->_parent->_matrix;
+		parentWorldTM = matrix * _node->_parent->_matrix;
 
 	// While we could compute the desired lookat direction directly in the above coordinate frame,
 	// it is preferrable to compute the lookat direction with respect to the head orientation in
@@ -159,6 +159,7 @@ void Head::Joint::orientTowards(bool entering, const Math::Vector3d &point, floa
 	_node->_animYaw = y - _node->_yaw;
 	_node->_animPitch = pt - _node->_pitch;
 	_node->_animRoll = r - _node->_roll;
+	_node->checkAnimation();
 }
 
 void Head::Joint::saveState(SaveGame *state) const {
@@ -65,11 +65,6 @@ void MeshComponent::reset() {
 	_node->_meshVisible = true;
 }
 
-int MeshComponent::update(uint /*time*/) {
-	_node->setMatrix(_matrix);
-	return 0;
-}
-
 void MeshComponent::saveState(SaveGame *state) {
 	state->writeBool(_node->_meshVisible);
 }
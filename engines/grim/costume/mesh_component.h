@@ -37,13 +37,10 @@ public:
 	void init();
 	CMap *cmap();
 	void setKey(int val);
-	int update(uint time);
 	void reset();
 	void saveState(SaveGame *state);
 	void restoreState(SaveGame *state);
 
-	void setMatrix(const Math::Matrix4 &matrix) { _matrix = matrix; };
-
 	ModelNode *getNode() { return _node; }
 	Model *getModel() { return _model; }
 
@@ -51,7 +48,6 @@ private:
 	int _num;
 	Model *_model;
 	ModelNode *_node;
-	Math::Matrix4 _matrix;
 };
 
 } // end of namespace Grim
@@ -132,6 +132,9 @@ void ModelComponent::animate() {
 	}
 
 	_animation->animate(_hier, getNumNodes());
+
+	for (int i = 0; i < getNumNodes(); i++)
+		_hier[i].checkAnimation();
 }
 
 void ModelComponent::resetColormap() {
@@ -150,22 +153,13 @@ int ModelComponent::getNumNodes() {
 	return _obj->getNumNodes();
 }
 
-void ModelComponent::translateObject(ModelNode *node, bool reset) {
-	if (node->_parent)
-		translateObject(node->_parent, reset);
-
-	if (reset) {
-		node->translateViewpointBack();
-	} else {
-		node->translateViewpoint();
-	}
-}
-
-void ModelComponent::translateObject(bool res) {
-	ModelNode *node = _hier->_parent;
-	if (node) {
-		translateObject(node, res);
-	}
+void ModelComponent::updateMatrices() {
+	// Models attached to a node of another one hang below it, so update
+	// from the root of the whole hierarchy
+	ModelNode *root = _hier;
+	while (root->_parent)
+		root = root->_parent;
+	root->update();
 }
 
 void ModelComponent::draw() {
@@ -174,14 +168,9 @@ void ModelComponent::draw() {
 
 	if (_parent && _parent->isVisible())
 			return;
-	// Need to translate object to be in accordance
-	// with the setup of the parent
-	translateObject(false);
 
+	updateMatrices();
 	_hier->draw();
-
-	// Need to un-translate when done
-	translateObject(true);
 }
 
 void ModelComponent::getBoundingBox(int *x1, int *y1, int *x2, int *y2) {
@@ -190,14 +179,9 @@ void ModelComponent::getBoundingBox(int *x1, int *y1, int *x2, int *y2) {
 
 	if (_parent && _parent->isVisible())
 		return;
-	// Need to translate object to be in accordance
-		// with the setup of the parent
-	translateObject(false);
 
+	updateMatrices();
 	_hier->getBoundingBox(x1, y1, x2, y2);
-
-	// Need to un-translate when done
-	translateObject(true);
 }
 
 } // end of namespace Grim
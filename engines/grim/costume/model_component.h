@@ -42,8 +42,7 @@ public:
 	void resetColormap();
 	void setMatrix(const Math::Matrix4 &matrix) { _matrix = matrix; };
 	void restoreState(SaveGame *state);
-	void translateObject(bool reset);
-	static void translateObject(ModelNode *node, bool reset);
+	void updateMatrices();
 	AnimManager *getAnimManager() const;
 
 	ModelNode *getHierarchy() { return _hier; }
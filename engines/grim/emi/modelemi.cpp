@@ -217,26 +217,90 @@ void EMIModel::setSkeleton(Skeleton *skel) {
 		}
 	}
 	
-	Math::Vector3d vertex;
-	Math::Matrix4 mat;
 	for (int i = 0; i < _numVertices; i++) {
-		vertex = _vertices[i];
-		if (_vertexBoneInfo[_vertexBone[i]] != -1) {
-			mat = _skeleton->_joints[_vertexBoneInfo[_vertexBone[i]]]._absMatrix;
-			mat.inverseTranslate(&vertex);
-			mat.inverseRotate(&vertex);
+		int joint = _vertexBoneInfo[_vertexBone[i]];
+		if (joint != -1) {
+			const Math::Matrix4 &mat = _skeleton->_joints[joint]._absMatrix;
+			mat.inverseTranslate(_vertices + i);
+			mat.inverseRotate(_vertices + i);
 		}
-		_vertices[i] = vertex;
 	}
+
+	// Group the vertices by joint (joint -1 ends up in the first group), so that
+	// every joint matrix is applied to a contiguous run of vertices.
+	freeSkinData();
+	int numJoints = _skeleton->_numJoints;
+	int *count = new int[numJoints + 1];
+	memset(count, 0, (numJoints + 1) * sizeof(int));
+	for (int i = 0; i < _numVertices; i++) {
+		count[_vertexBoneInfo[_vertexBone[i]] + 1]++;
+	}
+	_numSkinGroups = 0;
+	for (int j = 0; j <= numJoints; j++) {
+		if (count[j] > 0)
+			_numSkinGroups++;
+	}
+	_skinGroupJoint = new int[_numSkinGroups];
+	_skinGroupStart = new int[_numSkinGroups + 1];
+	int group = 0, start = 0;
+	for (int j = 0; j <= numJoints; j++) {
+		if (count[j] == 0)
+			continue;
+		_skinGroupJoint[group] = j - 1;
+		_skinGroupStart[group] = start;
+		start += count[j];
+		count[j] = _skinGroupStart[group];
+		group++;
+	}
+	_skinGroupStart[_numSkinGroups] = start;
+
+	_skinOrder = new int[_numVertices];
+	_skinVerts = new float[6 * _numVertices];
+	float *x = _skinVerts, *y = x + _numVertices, *z = y + _numVertices;
+	for (int i = 0; i < _numVertices; i++) {
+		int slot = count[_vertexBoneInfo[_vertexBone[i]] + 1]++;
+		_skinOrder[slot] = i;
+		x[slot] = _vertices[i].x();
+		y[slot] = _vertices[i].y();
+		z[slot] = _vertices[i].z();
+	}
+	delete[] count;
+	_skinnedPose = 0;
+}
+
+void EMIModel::freeSkinData() {
+	delete[] _skinGroupJoint; _skinGroupJoint = NULL;
+	delete[] _skinGroupStart; _skinGroupStart = NULL;
+	delete[] _skinOrder; _skinOrder = NULL;
+	delete[] _skinVerts; _skinVerts = NULL;
+	_numSkinGroups = 0;
 }
 
 void EMIModel::prepareForRender() {
-	if (!_skeleton || !_vertexBoneInfo)
+	if (!_skeleton || !_skinVerts)
 		return;
+	// Nothing to do if the skeleton did not move since the last time
+	if (_skinnedPose == _skeleton->getPoseGeneration())
+		return;
+	_skinnedPose = _skeleton->getPoseGeneration();
+
+	const float *x = _skinVerts, *y = x + _numVertices, *z = y + _numVertices;
+	float *outX = _skinVerts + 3 * _numVertices, *outY = outX + _numVertices, *outZ = outY + _numVertices;
+	for (int g = 0; g < _numSkinGroups; g++) {
+		int first = _skinGroupStart[g];
+		int count = _skinGroupStart[g + 1] - first;
+		int joint = _skinGroupJoint[g];
+		if (joint == -1) {
+			memcpy(outX + first, x + first, count * sizeof(float));
+			memcpy(outY + first, y + first, count * sizeof(float));
+			memcpy(outZ + first, z + first, count * sizeof(float));
+		} else {
+			_skeleton->_joints[joint]._finalMatrix.transformPoints(x + first, y + first, z + first,
+			                                                       outX + first, outY + first, outZ + first, count, true);
+		}
+	}
 	for (int i = 0; i < _numVertices; i++) {
-		_drawVertices[i] = _vertices[i];
-		int animIndex = _vertexBoneInfo[_vertexBone[i]];
-		_skeleton->_joints[animIndex]._finalMatrix.transform(_drawVertices + i, true);
+		_drawVertices[_skinOrder[i]].set(outX[i], outY[i], outZ[i]);
 	}
 }
 
@@ -246,7 +310,16 @@ void EMIModel::prepareTextures() {
 		// HACK: As we dont know what specialty-textures are yet, we skip loading them
 		if (!_texNames[i].contains("specialty"))
 			_mats[i] = g_resourceloader->loadMaterial(_texNames[i].c_str(), NULL);
-		else
+	}
+	bindSpecialtyTextures();
+}
+
+void EMIModel::bindSpecialtyTextures() {
+	if (!_mats)
+		return;
+	// They belong to the renderer, so they change when it is replaced
+	for (uint32 i = 0; i < _numTextures; i++) {
+		if (_texNames[i].contains("specialty"))
 			_mats[i] = g_driver->getSpecialtyTexture(_texNames[i][9] - '0');
 	}
 }
@@ -279,6 +352,12 @@ EMIModel::EMIModel(const Common::String &filename, Common::SeekableReadStream *d
 	_numBoneInfos = 0;
 	_vertexBoneInfo = NULL;
 	_vertexBone = NULL;
+	_numSkinGroups = 0;
+	_skinGroupJoint = NULL;
+	_skinGroupStart = NULL;
+	_skinOrder = NULL;
+	_skinVerts = NULL;
+	_skinnedPose = 0;
 	_skeleton = NULL;
 	_sphereData = new Math::Vector4d();
 	_boxData = new Math::Vector3d();
@@ -302,9 +381,11 @@ EMIModel::~EMIModel() {
 	delete[] _boneInfos;
 	delete[] _vertexBone;
 	delete[] _vertexBoneInfo;
+	freeSkinData();
 	delete _sphereData;
 	delete _boxData;
 	delete _boxData2;
+	g_resourceloader->uncacheModel(this);
 }
 
 } // end of namespace Grim
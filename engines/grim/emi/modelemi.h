@@ -96,6 +96,14 @@ public:
 	int *_vertexBoneInfo;
 	int *_vertexBone;
 
+	// Skinning data, the vertices are grouped by the joint they follow:
+	int _numSkinGroups;
+	int *_skinGroupJoint;
+	int *_skinGroupStart; // _numSkinGroups + 1 entries
+	int *_skinOrder;      // vertex index of every grouped slot
+	float *_skinVerts;    // bind pose x, y and z arrays, followed by the skinned ones
+	uint32 _skinnedPose;
+
 	// Stuff we dont know how to use:
 	Math::Vector4d *_sphereData;
 	Math::Vector3d *_boxData;
@@ -111,7 +119,9 @@ public:
 	void setSkeleton(Skeleton *skel);
 	void loadMesh(Common::SeekableReadStream *data);
 	void prepareForRender();
+	void freeSkinData();
 	void prepareTextures();
+	void bindSpecialtyTextures();
 	void draw();
 };
 
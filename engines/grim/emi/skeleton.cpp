@@ -33,12 +33,14 @@ namespace Grim {
 #define ROTATE_OP 4
 #define TRANSLATE_OP 3
 
-Skeleton::Skeleton(const Common::String &filename, Common::SeekableReadStream *data) : _anim(NULL), _time(0) {
+Skeleton::Skeleton(const Common::String &filename, Common::SeekableReadStream *data) : _anim(NULL), _time(0), _poseGeneration(1) {
 	loadSkeleton(data);
 }
 
 Skeleton::~Skeleton() {
 	delete[] _joints;
+	delete[] _poseRot;
+	delete[] _posePos;
 }
 
 void Skeleton::loadSkeleton(Common::SeekableReadStream *data) {
@@ -57,8 +59,13 @@ void Skeleton::loadSkeleton(Common::SeekableReadStream *data) {
 		_joints[i]._quat.readFromStream(data);
 		
 		_joints[i]._parentIndex = findJointIndex(_joints[i]._parent, i);
+		_joints[i]._animIndex[0] = -1;
+		_joints[i]._animIndex[1] = -1;
 	}
+	_poseRot = new Math::Quaternion[_numJoints];
+	_posePos = new Math::Vector3d[_numJoints];
 	initBones();
+	resetPose();
 	resetAnim();
 }
 	
@@ -85,6 +92,17 @@ void Skeleton::initBones() {
 
 void Skeleton::resetAnim() {
 	_time = 0;
+	for (int i = 0; i < _numJoints; i++) {
+		_joints[i]._animCursor[0] = 0;
+		_joints[i]._animCursor[1] = 0;
+	}
+}
+
+void Skeleton::resetPose() {
+	for (int i = 0; i < _numJoints; i++) {
+		_poseRot[i] = _joints[i]._quat;
+		_posePos[i] = _joints[i]._trans;
+	}
 }
 
 void Skeleton::setAnim(AnimationEmi *anim) {
@@ -108,6 +126,7 @@ void Skeleton::setAnim(AnimationEmi *anim) {
 			_joints[index]._animIndex[1] = i;
 		}
 	}
+	resetPose();
 	resetAnim();
 }
 
@@ -122,6 +141,30 @@ int Skeleton::findJointIndex(const Common::String & name, int max) const {
 	return -1;
 }
 
+/**
+ * Returns the index of the first keyframe at or after time, or 0 if there
+ * is none. The cursor keeps the previous result, so while the animation
+ * plays forward only the keyframes passed since the last frame are looked at.
+ */
+template<class T>
+static int findKeyframe(const T *keys, int count, float time, int &cursor) {
+	if (cursor > 0 && keys[cursor - 1]._time >= time) {
+		// The time went back, search the keyframes before the cursor
+		int low = 0, high = cursor - 1;
+		while (low < high) {
+			int mid = (low + high) / 2;
+			if (keys[mid]._time >= time)
+				high = mid;
+			else
+				low = mid + 1;
+		}
+		cursor = low;
+	}
+	while (cursor < count && keys[cursor]._time < time)
+		cursor++;
+	return cursor < count ? cursor : 0;
+}
+
 void Skeleton::animate(float delta) {
 	if (_anim == NULL)
 		return;
@@ -129,85 +172,65 @@ void Skeleton::animate(float delta) {
 	if (_time > _anim->_duration) {
 		resetAnim();
 	}
-	
-	Math::Vector3d vec;
 
+	// Sample the animated tracks into the local pose
 	for (int curJoint = 0; curJoint < _numJoints; curJoint++) {
-		int transIdx = _joints[curJoint]._animIndex[0];
-		int rotIdx = _joints[curJoint]._animIndex[1];
+		Joint &joint = _joints[curJoint];
+		int transIdx = joint._animIndex[0];
+		int rotIdx = joint._animIndex[1];
 
-		float timeDelta = 0.0f;
-		float interpVal = 0.0f;
-
-		Math::Matrix4 relFinal = _joints[curJoint]._relMatrix;
-		
-		if (rotIdx >= 0) {
-			int keyfIdx = 0;
-			Math::Quaternion quat;
+		if (rotIdx >= 0 && _anim->_bones[rotIdx]._count > 0) {
 			Bone *curBone = &_anim->_bones[rotIdx];
-			Math::Vector3d relPos = relFinal.getPosition();
-
-			// Find the right keyframe
-			for (int curKeyFrame = 0; curKeyFrame < curBone->_count; curKeyFrame++) {
-				if (curBone->_rotations[curKeyFrame]._time >= _time) {
-					keyfIdx = curKeyFrame;
-					break;
-				}
-			}
+			AnimRotation *keys = curBone->_rotations;
+			int keyfIdx = findKeyframe(keys, curBone->_count, _time, joint._animCursor[1]);
 
 			if (keyfIdx == 0) {
-				quat = curBone->_rotations[keyfIdx]._quat;
+				_poseRot[curJoint] = keys[keyfIdx]._quat;
 			} else if (keyfIdx == curBone->_count - 1) {
-				quat = curBone->_rotations[keyfIdx-1]._quat;
+				_poseRot[curJoint] = keys[keyfIdx - 1]._quat;
 			} else {
-				timeDelta = curBone->_rotations[keyfIdx-1]._time - curBone->_rotations[keyfIdx]._time;
-				interpVal = (_time - curBone->_rotations[keyfIdx]._time) / timeDelta;
+				float timeDelta = keys[keyfIdx - 1]._time - keys[keyfIdx]._time;
+				float interpVal = (_time - keys[keyfIdx]._time) / timeDelta;
 
 				// Might be the other way around (keyfIdx - 1 slerped against keyfIdx)
-				quat = curBone->_rotations[keyfIdx]._quat.slerpQuat(curBone->_rotations[keyfIdx - 1]._quat, interpVal);
+				_poseRot[curJoint] = keys[keyfIdx]._quat.slerpQuat(keys[keyfIdx - 1]._quat, interpVal);
 			}
-			quat.toMatrix(relFinal);
-			relFinal.setPosition(relPos);
 		}
 
-		if (transIdx >= 0) {
-			int keyfIdx = 0;
+		if (transIdx >= 0 && _anim->_bones[transIdx]._count > 0) {
 			Bone *curBone = &_anim->_bones[transIdx];
-			// Find the right keyframe
-			for (int curKeyFrame = 0; curKeyFrame < curBone->_count; curKeyFrame++) {
-				if (curBone->_translations[curKeyFrame]._time >= _time) {
-					keyfIdx = curKeyFrame;
-					break;
-				}
-			}
+			const AnimTranslation *keys = curBone->_translations;
+			int keyfIdx = findKeyframe(keys, curBone->_count, _time, joint._animCursor[0]);
 
 			if (keyfIdx == 0) {
-				vec = curBone->_translations[keyfIdx]._vec;
+				_posePos[curJoint] = keys[keyfIdx]._vec;
 			} else if (keyfIdx == curBone->_count - 1) {
-				vec = curBone->_translations[keyfIdx-1]._vec;
+				_posePos[curJoint] = keys[keyfIdx - 1]._vec;
 			} else {
-				timeDelta = curBone->_translations[keyfIdx-1]._time - curBone->_translations[keyfIdx]._time;
-				interpVal = (_time - curBone->_translations[keyfIdx]._time) / timeDelta;
+				float timeDelta = keys[keyfIdx - 1]._time - keys[keyfIdx]._time;
+				float interpVal = (_time - keys[keyfIdx]._time) / timeDelta;
+				const Math::Vector3d &prev = keys[keyfIdx - 1]._vec;
 
-				vec.x() = curBone->_translations[keyfIdx-1]._vec.x() +
-					(curBone->_translations[keyfIdx]._vec.x() - curBone->_translations[keyfIdx-1]._vec.x()) * interpVal;
-
-				vec.y() = curBone->_translations[keyfIdx-1]._vec.y() +
-					(curBone->_translations[keyfIdx]._vec.y() - curBone->_translations[keyfIdx-1]._vec.y()) * interpVal;
-
-				vec.z() = curBone->_translations[keyfIdx-1]._vec.z() +
-					(curBone->_translations[keyfIdx]._vec.z() - curBone->_translations[keyfIdx-1]._vec.z()) * interpVal;
+				_posePos[curJoint] = prev + (keys[keyfIdx]._vec - prev) * interpVal;
 			}
-			relFinal.setPosition(vec);
 		}
-		
-		if (_joints[curJoint]._parentIndex == -1) {
-			_joints[curJoint]._finalMatrix = relFinal;
+	}
+
+	// Concatenate the local poses, the parents always come before their children
+	Math::Matrix4 relFinal;
+	for (int curJoint = 0; curJoint < _numJoints; curJoint++) {
+		Joint &joint = _joints[curJoint];
+
+		_poseRot[curJoint].toMatrix(relFinal);
+		relFinal.setPosition(_posePos[curJoint]);
+
+		if (joint._parentIndex == -1) {
+			joint._finalMatrix = relFinal;
 		} else {
-			_joints[curJoint]._finalMatrix = _joints[_joints[curJoint]._parentIndex]._finalMatrix;
-			_joints[curJoint]._finalMatrix = _joints[curJoint]._finalMatrix * relFinal;
+			joint._finalMatrix = _joints[joint._parentIndex]._finalMatrix * relFinal;
 		}
-	} // end for
+	}
+	_poseGeneration++;
 }
 
 bool Skeleton::hasJoint(const Common::String & name) const {
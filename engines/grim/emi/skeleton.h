@@ -43,6 +43,7 @@ struct Joint {
 	Math::Quaternion _quat;
 	// calculated;
 	int _animIndex[2];
+	int _animCursor[2];
 	int _parentIndex;
 	Math::Matrix4 _absMatrix;
 	Math::Matrix4 _relMatrix;
@@ -52,9 +53,15 @@ struct Joint {
 class Skeleton : public Object {
 
 	AnimationEmi *_anim;
+	// Local pose of every joint, sampled from the animation
+	Math::Quaternion *_poseRot;
+	Math::Vector3d *_posePos;
+
 	void loadSkeleton(Common::SeekableReadStream *data);
 	void initBone(int index);
 	void initBones();
+	void resetPose();
+	uint32 _poseGeneration;
 public:
 	int _numJoints;
 	Joint *_joints;
@@ -64,6 +71,10 @@ public:
 	void resetAnim();
 	void setAnim(AnimationEmi *anim);
 	void animate(float time);
+	/**
+	 * Returns a counter that changes every time the joint matrices are recomputed.
+	 */
+	uint32 getPoseGeneration() const { return _poseGeneration; }
 	int findJointIndex(const Common::String & name, int max) const;
 	bool hasJoint(const Common::String & name) const;
 	Joint * getJointNamed(const Common::String & name) const;
@@ -41,7 +41,7 @@ Font::Font() :
 		_userData(NULL),
 		_fontData(NULL), _charHeaders(NULL), _charIndex(NULL)
 {
-
+	memset(_charLookup, 0xff, sizeof(_charLookup));
 }
 
 Font::~Font() {
@@ -97,12 +97,12 @@ void Font::load(const Common::String &filename, Common::SeekableReadStream *data
 
 	data->read(_fontData, _dataSize);
 
+	buildCharLookup();
+
 	g_driver->createFont(this);
 }
 
-uint16 Font::getCharIndex(unsigned char c) const {
-	uint16 c2 = uint16(c);
-
+void Font::buildCharLookup() {
 	// In order to ensure the correct character codes for
 	// accented characters it is necessary to check the
 	// requested code against the index of characters for
@@ -114,16 +114,27 @@ uint16 Font::getCharIndex(unsigned char c) const {
 	// for the first time and he says "Buenos Días" the
 	// 'í' character will either show up as a different
 	// character or it crashes the game.
-
-	if (_charIndex[c2] == c2) {
-		return c2;
+	for (uint c = 0; c < 256; ++c) {
+		_charLookup[c] = kNoGlyph;
+		if (c < _numChars && _charIndex[c] == c) {
+			_charLookup[c] = c;
+			continue;
+		}
+		for (uint i = 0; i < _numChars; ++i) {
+			if (_charIndex[i] == c) {
+				_charLookup[c] = i;
+				break;
+			}
+		}
 	}
+}
 
-	for (uint i = 0; i < _numChars; ++i) {
-		if (_charIndex[i] == c2)
-			return i;
-	}
-	Debug::warning(Debug::Fonts, "The requsted character (code 0x%x) does not correspond to anything in the font data!", c2);
+uint16 Font::getCharIndex(unsigned char c) const {
+	uint16 index = _charLookup[c];
+	if (index != kNoGlyph)
+		return index;
+
+	Debug::warning(Debug::Fonts, "The requsted character (code 0x%x) does not correspond to anything in the font data!", c);
 	// If we couldn't find the character then default to
 	// the first character in the font so that something
 	// gets loaded to prevent the game from crashing
@@ -64,11 +64,14 @@ public:
 
 	void saveState(SaveGame *state) const;
 	void restoreState(SaveGame *state);
+	// The font file name, which is all we save, never changes once loaded.
+	uint32 getSaveGeneration() const { return 1; }
 
 	static const uint8 emerFont[][13];
 private:
 
 	uint16 getCharIndex(unsigned char c) const;
+	void buildCharLookup();
 	struct CharHeader {
 		int32 offset;
 		int8  width;
@@ -83,6 +86,9 @@ private:
 	uint32 _height, _baseOffsetY;
 	uint32 _firstChar, _lastChar;
 	uint16 *_charIndex;
+	// Glyph index of every character code, kNoGlyph if the font lacks it
+	uint16 _charLookup[256];
+	static const uint16 kNoGlyph = 0xffff;
 	CharHeader *_charHeaders;
 	byte *_fontData;
 	Common::String _filename;
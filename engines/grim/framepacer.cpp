@@ -0,0 +1,192 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include "engines/grim/framepacer.h"
+
+namespace Grim {
+
+FramePacer::FramePacer() :
+	_frameDuration(0), _frameStart(0), _deadline(0), _resync(true), _currentPhase(-1),
+	_phaseStart(0), _historyPos(0), _historyCount(0), _frameNumber(0) {
+
+	memset(&_current, 0, sizeof(_current));
+}
+
+void FramePacer::setFrameDuration(uint32 duration) {
+	_frameDuration = duration;
+	_resync = true;
+}
+
+void FramePacer::beginFrame() {
+	_frameStart = g_system->getMicros();
+	if (_resync) {
+		_deadline = _frameStart + _frameDuration;
+		_resync = false;
+	}
+
+	memset(&_current, 0, sizeof(_current));
+	_current._number = _frameNumber++;
+	_currentPhase = -1;
+}
+
+void FramePacer::beginPhase(Phase phase) {
+	endPhase();
+
+	_currentPhase = phase;
+	_phaseStart = g_system->getMicros();
+}
+
+void FramePacer::endPhase() {
+	if (_currentPhase < 0)
+		return;
+
+	// A phase may run more than once per frame, e.g. Lua is also run
+	// for the input events.
+	_current._phases[_currentPhase] += g_system->getMicros() - _phaseStart;
+	_currentPhase = -1;
+}
+
+void FramePacer::endFrame() {
+	endPhase();
+
+	uint32 now = g_system->getMicros();
+	_current._work = now - _frameStart;
+
+	if (_frameDuration > 0) {
+		int32 remaining = (int32)(_deadline - now);
+		if (remaining < -(int32)(kMaxDebtFrames * _frameDuration)) {
+			_deadline = now;
+			remaining = 0;
+		}
+
+		if (remaining > (int32)kSpinThreshold)
+			g_system->delayMicros(remaining - kSpinThreshold);
+		while ((int32)(_deadline - g_system->getMicros()) > 0)
+			;
+
+		_deadline += _frameDuration;
+		now = g_system->getMicros();
+	}
+	_current._total = now - _frameStart;
+
+	_history[_historyPos] = _current;
+	_historyPos = (_historyPos + 1) % kHistorySize;
+	if (_historyCount < kHistorySize)
+		++_historyCount;
+}
+
+const FramePacer::FrameTimes &FramePacer::getFrame(int age) const {
+	assert(age < _historyCount);
+	return _history[(_historyPos - 1 - age + kHistorySize) % kHistorySize];
+}
+
+const char *FramePacer::getPhaseName(Phase phase) {
+	switch (phase) {
+	case PhaseLua:
+		return "lua";
+	case PhaseUpdate:
+		return "update";
+	case PhaseDraw:
+		return "draw";
+	case PhaseFlip:
+		return "flip";
+	default:
+		return "unknown";
+	}
+}
+
+Common::String FramePacer::getStatistics() const {
+	if (_historyCount == 0)
+		return "No frame recorded\n";
+
+	Common::String str = Common::String::format("Last %d frames, target %.2f ms per frame\n", _historyCount, _frameDuration / 1000.f);
+
+	uint32 sums[PhaseCount + 2];
+	uint32 maxs[PhaseCount + 2];
+	memset(sums, 0, sizeof(sums));
+	memset(maxs, 0, sizeof(maxs));
+	int histogram[kHistogramBuckets];
+	memset(histogram, 0, sizeof(histogram));
+
+	for (int i = 0; i < _historyCount; ++i) {
+		const FrameTimes &frame = getFrame(i);
+		for (int j = 0; j < PhaseCount; ++j) {
+			sums[j] += frame._phases[j];
+			maxs[j] = MAX(maxs[j], frame._phases[j]);
+		}
+		sums[PhaseCount] += frame._work;
+		maxs[PhaseCount] = MAX(maxs[PhaseCount], frame._work);
+		sums[PhaseCount + 1] += frame._total;
+		maxs[PhaseCount + 1] = MAX(maxs[PhaseCount + 1], frame._total);
+
+		++histogram[MIN<uint32>(frame._total / 1000, (uint32)kHistogramBuckets - 1)];
+	}
+
+	for (int j = 0; j < PhaseCount + 2; ++j) {
+		const char *name = j < PhaseCount ? getPhaseName((Phase)j) : (j == PhaseCount ? "work" : "total");
+		str += Common::String::format("%-8s avg %7.2f ms  max %7.2f ms\n", name,
+		                              sums[j] / 1000.f / _historyCount, maxs[j] / 1000.f);
+	}
+
+	int maxBucket = 1;
+	for (int i = 0; i < kHistogramBuckets; ++i)
+		maxBucket = MAX(maxBucket, histogram[i]);
+
+	str += "Frame time histogram:\n";
+	for (int i = 0; i < kHistogramBuckets; ++i) {
+		if (histogram[i] == 0)
+			continue;
+		str += Common::String::format("%s%2d ms %5d ", i == kHistogramBuckets - 1 ? ">=" : "  ", i, histogram[i]);
+		int length = (histogram[i] * 40 + maxBucket - 1) / maxBucket;
+		for (int j = 0; j < length; ++j)
+			str += '#';
+		str += '\n';
+	}
+
+	return str;
+}
+
+void FramePacer::dumpCSV(Common::WriteStream *stream) const {
+	Common::String line = "frame";
+	for (int j = 0; j < PhaseCount; ++j) {
+		line += ",";
+		line += getPhaseName((Phase)j);
+	}
+	line += ",work,total\n";
+	stream->writeString(line);
+
+	for (int i = _historyCount - 1; i >= 0; --i) {
+		const FrameTimes &frame = getFrame(i);
+		line = Common::String::format("%u", frame._number);
+		for (int j = 0; j < PhaseCount; ++j) {
+			line += Common::String::format(",%u", frame._phases[j]);
+		}
+		line += Common::String::format(",%u,%u\n", frame._work, frame._total);
+		stream->writeString(line);
+	}
+}
+
+} // end of namespace Grim
@@ -0,0 +1,133 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRIM_FRAMEPACER_H
+#define GRIM_FRAMEPACER_H
+
+#include "common/str.h"
+
+namespace Common {
+class WriteStream;
+}
+
+namespace Grim {
+
+/**
+ * Paces the main loop at a fixed frame rate with microsecond resolution and
+ * keeps timing statistics about the last frames.
+ *
+ * The pacer sleeps until shortly before the deadline of the frame and then
+ * spins until it is reached. The deadline of the next frame is computed from
+ * the previous one instead of from the current time, so that a frame which
+ * ends late is compensated by the following ones.
+ */
+class FramePacer {
+public:
+	enum Phase {
+		PhaseLua = 0,
+		PhaseUpdate,
+		PhaseDraw,
+		PhaseFlip,
+		PhaseCount
+	};
+
+	FramePacer();
+
+	/**
+	 * Set the target frame duration, in microseconds. 0 disables the limit.
+	 */
+	void setFrameDuration(uint32 duration);
+	uint32 getFrameDuration() const { return _frameDuration; }
+
+	/**
+	 * Mark the beginning of a new frame. Must be called once per main loop iteration.
+	 */
+	void beginFrame();
+	/**
+	 * Start measuring the time spent in a phase of the current frame.
+	 * Any phase that was being measured is ended.
+	 */
+	void beginPhase(Phase phase);
+	void endPhase();
+
+	/**
+	 * Wait until the deadline of the current frame, and record its timings.
+	 */
+	void endFrame();
+
+	/**
+	 * Forget the accumulated deadline debt, e.g. after a long loading operation.
+	 */
+	void resync() { _resync = true; }
+
+	/**
+	 * Return a human readable summary of the timings of the last frames, with
+	 * a histogram of the frame times.
+	 */
+	Common::String getStatistics() const;
+	/**
+	 * Write the timings of the last frames in CSV format.
+	 */
+	void dumpCSV(Common::WriteStream *stream) const;
+
+	static const char *getPhaseName(Phase phase);
+
+private:
+	struct FrameTimes {
+		uint32 _number;
+		uint32 _phases[PhaseCount];
+		uint32 _work;
+		uint32 _total;
+	};
+
+	// Number of frames kept for the statistics
+	static const int kHistorySize = 512;
+	// The sleep granularity of most systems is about a millisecond, so don't
+	// sleep when the deadline is closer than this.
+	static const uint32 kSpinThreshold = 1000;
+	// A frame can't be late by more than this many frames: trying to catch up
+	// more would only cause a burst of unpaced frames.
+	static const uint32 kMaxDebtFrames = 3;
+	// Number of buckets, of one millisecond each, of the frame time histogram.
+	// Frames longer than that go in the last bucket.
+	static const int kHistogramBuckets = 40;
+
+	const FrameTimes &getFrame(int age) const;
+
+	uint32 _frameDuration;
+	uint32 _frameStart;
+	uint32 _deadline;
+	bool _resync;
+
+	int _currentPhase;
+	uint32 _phaseStart;
+	FrameTimes _current;
+
+	FrameTimes _history[kHistorySize];
+	int _historyPos;
+	int _historyCount;
+	uint32 _frameNumber;
+};
+
+} // end of namespace Grim
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include "engines/grim/gfx_base.h"
+#include "engines/grim/model.h"
 #include "engines/grim/savegame.h"
 
 namespace Grim {
@@ -33,6 +34,18 @@ GfxBase::GfxBase() :
 	_currentQuat(0,0,0,1),
 	_dimLevel(0.0f) {
 
+	memset(&_frameStats, 0, sizeof(_frameStats));
+	memset(&_lastFrameStats, 0, sizeof(_lastFrameStats));
+}
+
+void GfxBase::drawMesh(const Mesh *mesh) {
+	for (int i = 0; i < mesh->_numFaces; i++)
+		mesh->_faces[i].draw(mesh->_vertices, mesh->_vertNormals, mesh->_textureVerts, mesh->_lightingMode != 0);
+}
+
+void GfxBase::finishFrameStats() {
+	_lastFrameStats = _frameStats;
+	memset(&_frameStats, 0, sizeof(_frameStats));
 }
 
 void GfxBase::setShadowMode() {
@@ -97,6 +110,16 @@ void SpecialtyMaterial::select() const {
 }
 
 void SpecialtyMaterial::create(const char *data, int width, int height) {
+	if (_pixels != data) {
+		delete[] _pixels;
+		_pixels = new char[width * height * 4];
+		memcpy(_pixels, data, width * height * 4);
+	}
+	_width = width;
+	_height = height;
+
+	if (_texture && _texture->_texture)
+		g_driver->destroyMaterial(_texture);
 	delete _texture;
 	_texture = new Texture();
 	_texture->_width = width;
@@ -106,4 +129,35 @@ void SpecialtyMaterial::create(const char *data, int width, int height) {
 	g_driver->createMaterial(_texture, data, NULL);
 }
 
+void SpecialtyMaterial::release(SpecialtyMaterial &to) {
+	if (_texture && _texture->_texture)
+		g_driver->destroyMaterial(_texture);
+	delete _texture;
+	_texture = NULL;
+
+	delete[] to._pixels;
+	to._pixels = _pixels;
+	to._width = _width;
+	to._height = _height;
+	_pixels = NULL;
+	_width = _height = 0;
+}
+
+void SpecialtyMaterial::restore() {
+	if (_pixels)
+		create(_pixels, _width, _height);
+}
+
+void GfxBase::releaseSpecialtyTextures(SpecialtyMaterial *to) {
+	for (int i = 0; i < kNumSpecialtyTextures; ++i)
+		_specialty[i].release(to[i]);
+}
+
+void GfxBase::restoreSpecialtyTextures(SpecialtyMaterial *from) {
+	for (int i = 0; i < kNumSpecialtyTextures; ++i) {
+		from[i].release(_specialty[i]);
+		_specialty[i].restore();
+	}
+}
+
 }
@@ -57,11 +57,22 @@ class Texture;
 
 class SpecialtyMaterial : public Material {
 public:
-	SpecialtyMaterial() { _texture = NULL; }
-	~SpecialtyMaterial() { delete _texture; }
+	SpecialtyMaterial() { _texture = NULL; _pixels = NULL; _width = _height = 0; }
+	~SpecialtyMaterial() { delete _texture; delete[] _pixels; }
 	void create(const char *data, int width, int height);
+	/**
+	 * Destroy the texture on the current renderer and give the pixels it was
+	 * created from to another specialty material, which may create it again
+	 * with restore() once another renderer is in place.
+	 */
+	void release(SpecialtyMaterial &to);
+	void restore();
 	virtual void select() const;
 	Texture *_texture;
+
+private:
+	char *_pixels;
+	int _width, _height;
 };
 
 /**
@@ -76,6 +87,15 @@ enum colorFormat {
 };
 class GfxBase {
 public:
+	/**
+	 * Counters of the work submitted to the renderer in a frame.
+	 */
+	struct RenderStats {
+		uint32 drawCalls;     // calls drawing primitives
+		uint32 stateChanges;  // texture, material and lighting changes
+		uint32 faces;         // model faces drawn
+	};
+
 	GfxBase();
 	virtual ~GfxBase() { ; }
 
@@ -113,6 +133,12 @@ public:
 	 */
 	virtual void flipBuffer() = 0;
 
+	/**
+	 * Tell the renderer that something else drew over the screen, like
+	 * the GUI, so that none of it can be assumed to be still there.
+	 */
+	virtual void invalidateScreen() {}
+
 	virtual void getBoundingBoxPos(const Mesh *mesh, int *x1, int *y1, int *x2, int *y2) = 0;
 	virtual void startActorDraw(const Math::Vector3d &pos, float scale, const Math::Quaternion &quat,
 	                            const bool inOverworld, const float alpha) = 0;
@@ -131,10 +157,17 @@ public:
 	virtual void translateViewpointStart() = 0;
 	virtual void translateViewpoint(const Math::Vector3d &vec) = 0;
 	virtual void rotateViewpoint(const Math::Angle &angle, const Math::Vector3d &axis) = 0;
+	virtual void transformViewpoint(const Math::Matrix4 &matrix) = 0;
 	virtual void translateViewpointFinish() = 0;
 
 	virtual void drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face) = 0;
 	virtual void drawModelFace(const MeshFace *face, float *vertices, float *vertNormals, float *textureVerts) = 0;
+
+	/**
+	 * Draws all the faces of a mesh. The default implementation draws
+	 * them one by one with drawModelFace.
+	 */
+	virtual void drawMesh(const Mesh *mesh);
 	virtual void drawSprite(const Sprite *sprite) = 0;
 
 	virtual void enableLights() = 0;
@@ -154,13 +187,35 @@ public:
 	 * is called. Must be called before drawBitmap can be used.
 	 *
 	 * the external bitmap might have its data changed by this function,
+	 * only the images whose data is available are prepared.
 	 *
 	 * @param bitmap	the bitmap to be prepared
 	 * @see destroyBitmap
 	 * @see drawBitmap
+	 * @see createBitmapImage
 	 */
 	virtual void createBitmap(BitmapData *bitmap) = 0;
 
+	/**
+	 * Prepares a single image of a bitmap for which createBitmap was
+	 * already called, once the data of the image became available.
+	 *
+	 * @param bitmap	the bitmap the image belongs to
+	 * @param pic		the zero-based index of the image
+	 * @see destroyBitmapImage
+	 */
+	virtual void createBitmapImage(BitmapData *bitmap, int pic) = 0;
+
+	/**
+	 * Deletes the internal representation of a single image, after this
+	 * is called it is safe to dispose of the data of that image.
+	 *
+	 * @param bitmap	the bitmap the image belongs to
+	 * @param pic		the zero-based index of the image
+	 * @see createBitmapImage
+	 */
+	virtual void destroyBitmapImage(BitmapData *bitmap, int pic) = 0;
+
 	/**
 	 * Draws a bitmap
 	 * before this is safe to use, createBitmap MUST have been called
@@ -247,16 +302,41 @@ public:
 
 	void renderBitmaps(bool render);
 	void renderZBitmaps(bool render);
+	bool getRenderBitmaps() const { return _renderBitmaps; }
+	bool getRenderZBitmaps() const { return _renderZBitmaps; }
 
 	virtual void selectScreenBuffer() {}
 	virtual void selectCleanBuffer() {}
 	virtual void clearCleanBuffer() {}
 	virtual void drawCleanBuffer() {}
 
+	enum { kNumSpecialtyTextures = 8 };
 	virtual void createSpecialtyTextures() = 0;
 	virtual Material *getSpecialtyTexture(int n) { return &_specialty[n]; }
+	/**
+	 * Release the specialty textures of this renderer, moving their pixels to
+	 * @a to, so that restoreSpecialtyTextures() of another renderer can
+	 * create them again. They are copies of the screen which can't be read
+	 * back once this renderer is deleted.
+	 */
+	void releaseSpecialtyTextures(SpecialtyMaterial *to);
+	void restoreSpecialtyTextures(SpecialtyMaterial *from);
+
+	/**
+	 * Returns the counters of the last complete frame. Not every renderer
+	 * counts all of them.
+	 */
+	const RenderStats &getRenderStats() const { return _lastFrameStats; }
 
 protected:
+	/**
+	 * Makes the counters of the current frame the ones of the last
+	 * complete frame, must be called by flipBuffer.
+	 */
+	void finishFrameStats();
+
+	RenderStats _frameStats;
+	RenderStats _lastFrameStats;
 	static const int _gameHeight = 480;
 	static const int _gameWidth = 640;
 	float _scaleW, _scaleH;
@@ -270,7 +350,7 @@ protected:
 	bool _renderZBitmaps;
 	bool _shadowModeActive;
 	Graphics::PixelFormat _pixelFormat;
-	SpecialtyMaterial _specialty[8];
+	SpecialtyMaterial _specialty[kNumSpecialtyTextures];
 	Math::Vector3d _currentPos;
 	Math::Quaternion _currentQuat;
 	float _dimLevel;
@@ -96,6 +96,10 @@ GfxOpenGL::GfxOpenGL() {
 	_storedDisplay = NULL;
 	_emergFont = 0;
 	_alpha = 1.f;
+	_quadTexture = 0;
+	_emiColorsModel = NULL;
+	_emiColorsDim = 0.f;
+	_emiColorsAlpha = 1.f;
 }
 
 GfxOpenGL::~GfxOpenGL() {
@@ -246,6 +250,9 @@ void GfxOpenGL::clearScreen() {
 
 void GfxOpenGL::flipBuffer() {
 	g_system->updateScreen();
+	finishFrameStats();
+	// Models may be freed and others allocated at the same address
+	_emiColorsModel = NULL;
 }
 
 bool GfxOpenGL::isHardwareAccelerated() {
@@ -472,6 +479,7 @@ void GfxOpenGL::drawShadowPlanes() {
 	glDisable(GL_TEXTURE_2D);
 	for (SectorListType::iterator i = _currentShadowArray->planeList.begin(); i != _currentShadowArray->planeList.end(); ++i) {
 		Sector *shadowSector = i->sector;
+		_frameStats.drawCalls++;
 		glBegin(GL_POLYGON);
 		for (int k = 0; k < shadowSector->getNumVertices(); k++) {
 			glVertex3f(shadowSector->getVertices()[k].x(), shadowSector->getVertices()[k].y(), shadowSector->getVertices()[k].z());
@@ -513,9 +521,28 @@ void GfxOpenGL::set3DMode() {
 	glDepthFunc(GL_LESS);
 }
 
-void GfxOpenGL::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face) {
-	int *indices = (int*)face->_indexes;
+const byte *GfxOpenGL::getEMIColors(const EMIModel *model) {
+	float dim = 1.0f - _dimLevel;
+	if (dim == 1.0f && _alpha == 1.f)
+		return (const byte *)model->_colorMap;
+
+	if (_emiColorsModel != model || _emiColorsDim != dim || _emiColorsAlpha != _alpha) {
+		_emiColors.resize(4 * model->_numVertices);
+		for (int i = 0; i < model->_numVertices; i++) {
+			const EMIColormap &color = model->_colorMap[i];
+			_emiColors[4 * i + 0] = (byte)(color.r * dim);
+			_emiColors[4 * i + 1] = (byte)(color.g * dim);
+			_emiColors[4 * i + 2] = (byte)(color.b * dim);
+			_emiColors[4 * i + 3] = (byte)(int)(color.a * _alpha);
+		}
+		_emiColorsModel = model;
+		_emiColorsDim = dim;
+		_emiColorsAlpha = _alpha;
+	}
+	return &_emiColors[0];
+}
 
+void GfxOpenGL::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face) {
 	glEnable(GL_DEPTH_TEST);
 	glDisable(GL_ALPHA_TEST);
 	glDisable(GL_LIGHTING);
@@ -524,22 +551,26 @@ void GfxOpenGL::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face)
 	else
 		glDisable(GL_TEXTURE_2D);
 
-	float dim = 1.0f - _dimLevel;
-	glBegin(GL_TRIANGLES);
-	for (uint j = 0; j < face->_faceLength * 3; j++) {
-		int index = indices[j];
-		if (face->_hasTexture) {
-			glTexCoord2f(model->_texVerts[index].getX(), model->_texVerts[index].getY());
-		}
-		glColor4ub((byte)(model->_colorMap[index].r * dim), (byte)(model->_colorMap[index].g * dim), (byte)(model->_colorMap[index].b * dim), (int)(model->_colorMap[index].a * _alpha));
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, sizeof(Math::Vector3d), model->_drawVertices[0].getData());
+	glNormalPointer(GL_FLOAT, sizeof(Math::Vector3d), model->_normals[0].getData());
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, getEMIColors(model));
+	if (face->_hasTexture) {
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, sizeof(Math::Vector2d), model->_texVerts[0].getData());
+	}
 
-		Math::Vector3d normal = model->_normals[index];
-		Math::Vector3d vertex = model->_drawVertices[index];
+	glDrawElements(GL_TRIANGLES, face->_faceLength * 3, GL_UNSIGNED_INT, face->_indexes);
+	_frameStats.drawCalls++;
+	_frameStats.faces += face->_faceLength;
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 
-		glNormal3fv(normal.getData());
-		glVertex3fv(vertex.getData());
-	}
-	glEnd();
 	glEnable(GL_TEXTURE_2D);
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_ALPHA_TEST);
@@ -565,6 +596,59 @@ void GfxOpenGL::drawModelFace(const MeshFace *face, float *vertices, float *vert
 		glVertex3fv(vertices + 3 * face->_vertices[i]);
 	}
 	glEnd();
+	_frameStats.drawCalls++;
+	_frameStats.faces++;
+	// Done with transparency-capable objects
+	glDisable(GL_ALPHA_TEST);
+}
+
+void GfxOpenGL::drawMesh(const Mesh *mesh) {
+	// Support transparency in actor objects, such as the message tube
+	// in Manny's Office
+	glAlphaFunc(GL_GREATER, 0.5);
+	glEnable(GL_ALPHA_TEST);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, mesh->_drawVertices);
+	glNormalPointer(GL_FLOAT, 0, mesh->_drawNormals);
+	glTexCoordPointer(2, GL_FLOAT, 0, mesh->_drawTexVerts);
+
+	bool shadowMode = isShadowModeActive();
+	int i = 0;
+	while (i < mesh->_numFaces) {
+		// The faces are sorted by material, draw the ones sharing the
+		// material and the lighting of this one at once
+		const MeshFace *face = &mesh->_faces[mesh->_drawOrder[i]];
+		int end = i + 1;
+		while (end < mesh->_numFaces) {
+			const MeshFace *next = &mesh->_faces[mesh->_drawOrder[end]];
+			if (next->_material != face->_material || (next->_light == 0) != (face->_light == 0))
+				break;
+			end++;
+		}
+
+		// Meshes with lighting mode 0 are drawn with the lights already off,
+		// and must keep them off until the end
+		bool unlit = face->_light == 0 && !shadowMode && mesh->_lightingMode != 0;
+		if (unlit)
+			disableLights();
+		if (face->_material)
+			face->_material->select();
+
+		glDrawArrays(GL_TRIANGLES, mesh->_drawFirst[i], mesh->_drawFirst[end] - mesh->_drawFirst[i]);
+		_frameStats.drawCalls++;
+		_frameStats.faces += end - i;
+
+		if (unlit)
+			enableLights();
+		i = end;
+	}
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 	// Done with transparency-capable objects
 	glDisable(GL_ALPHA_TEST);
 }
@@ -598,6 +682,7 @@ void GfxOpenGL::drawSprite(const Sprite *sprite) {
 	float halfWidth = (sprite->_width / 2) * _scaleW;
 	float halfHeight = (sprite->_height / 2) * _scaleH;
 
+	_frameStats.drawCalls++;
 	glBegin(GL_POLYGON);
 	glTexCoord2f(0.0f, 1.0f);
 	glVertex3f(-halfWidth, -halfHeight, 0.0f);
@@ -629,6 +714,13 @@ void GfxOpenGL::rotateViewpoint(const Math::Angle &angle, const Math::Vector3d &
 	glRotatef(angle.getDegrees(), axis.x(), axis.y(), axis.z());
 }
 
+void GfxOpenGL::transformViewpoint(const Math::Matrix4 &matrix) {
+	// Math::Matrix4 is stored by rows, OpenGL wants it by columns
+	Math::Matrix4 m = matrix;
+	m.transpose();
+	glMultMatrixf(m.getData());
+}
+
 void GfxOpenGL::translateViewpointFinish() {
 	glMatrixMode(GL_MODELVIEW);
 	glPopMatrix();
@@ -636,10 +728,12 @@ void GfxOpenGL::translateViewpointFinish() {
 
 void GfxOpenGL::enableLights() {
 	glEnable(GL_LIGHTING);
+	_frameStats.stateChanges++;
 }
 
 void GfxOpenGL::disableLights() {
 	glDisable(GL_LIGHTING);
+	_frameStats.stateChanges++;
 }
 
 void GfxOpenGL::setupLight(Light *light, int lightId) {
@@ -691,44 +785,89 @@ void GfxOpenGL::turnOffLight(int lightId) {
 	glDisable(GL_LIGHT0 + lightId);
 }
 
+void GfxOpenGL::bindQuadTexture(GLuint texture) {
+	if (texture != _quadTexture)
+		flushQuads();
+	_quadTexture = texture;
+}
+
+void GfxOpenGL::addQuadVertex(float x, float y, float s, float t) {
+	_quadVerts.push_back(x);
+	_quadVerts.push_back(y);
+	_quadVerts.push_back(s);
+	_quadVerts.push_back(t);
+}
+
+void GfxOpenGL::flushQuads() {
+	if (_quadVerts.empty())
+		return;
+
+	glBindTexture(GL_TEXTURE_2D, _quadTexture);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 4 * sizeof(float), &_quadVerts[0]);
+	glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(float), &_quadVerts[2]);
+	glDrawArrays(GL_QUADS, 0, _quadVerts.size() / 4);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	_frameStats.drawCalls++;
+	_frameStats.stateChanges++;
+
+	// Keep the storage for the next quads
+	_quadVerts.resize(0);
+}
+
 #define BITMAP_TEXTURE_SIZE 256
 
 void GfxOpenGL::createBitmap(BitmapData *bitmap) {
-	GLuint *textures;
+	if (bitmap->_format == 1 || _useDepthShader) {
+		bitmap->_hasTransparency = false;
+		bitmap->_numTex = ((bitmap->_width + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE) *
+			((bitmap->_height + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE);
+		// The textures of an image are only generated once its data is available
+		GLuint *textures = new GLuint[bitmap->_numTex * bitmap->_numImages];
+		memset(textures, 0, bitmap->_numTex * bitmap->_numImages * sizeof(GLuint));
+		bitmap->_texIds = textures;
+	}
 
+	for (int pic = 0; pic < bitmap->_numImages; pic++) {
+		if (bitmap->hasImageData(pic))
+			createBitmapImage(bitmap, pic);
+	}
+
+	if (bitmap->_format == 1 || _useDepthShader) {
+		bitmap->freeData();
+	}
+}
+
+void GfxOpenGL::createBitmapImage(BitmapData *bitmap, int pic) {
 	if (bitmap->_format != 1) {
-		for (int pic = 0; pic < bitmap->_numImages; pic++) {
-			uint16 *zbufPtr = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
-			for (int i = 0; i < (bitmap->_width * bitmap->_height); i++) {
-				uint16 val = READ_LE_UINT16(zbufPtr + i);
-				// fix the value if it is incorrectly set to the bitmap transparency color
-				if (val == 0xf81f) {
-					val = 0;
-				}
-				zbufPtr[i] = 0xffff - ((uint32)val) * 0x10000 / 100 / (0x10000 - val);
+		uint16 *zbufPtr = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
+		for (int i = 0; i < (bitmap->_width * bitmap->_height); i++) {
+			uint16 val = READ_LE_UINT16(zbufPtr + i);
+			// fix the value if it is incorrectly set to the bitmap transparency color
+			if (val == 0xf81f) {
+				val = 0;
 			}
+			zbufPtr[i] = 0xffff - ((uint32)val) * 0x10000 / 100 / (0x10000 - val);
+		}
 
-			// Flip the zbuffer image to match what GL expects
-			if (!_useDepthShader) {
-				for (int y = 0; y < bitmap->_height / 2; y++) {
-					uint16 *ptr1 = zbufPtr + y * bitmap->_width;
-					uint16 *ptr2 = zbufPtr + (bitmap->_height - 1 - y) * bitmap->_width;
-					for (int x = 0; x < bitmap->_width; x++, ptr1++, ptr2++) {
-						uint16 tmp = *ptr1;
-						*ptr1 = *ptr2;
-						*ptr2 = tmp;
-					}
+		// Flip the zbuffer image to match what GL expects
+		if (!_useDepthShader) {
+			for (int y = 0; y < bitmap->_height / 2; y++) {
+				uint16 *ptr1 = zbufPtr + y * bitmap->_width;
+				uint16 *ptr2 = zbufPtr + (bitmap->_height - 1 - y) * bitmap->_width;
+				for (int x = 0; x < bitmap->_width; x++, ptr1++, ptr2++) {
+					uint16 tmp = *ptr1;
+					*ptr1 = *ptr2;
+					*ptr2 = tmp;
 				}
 			}
 		}
 	}
 	if (bitmap->_format == 1 || _useDepthShader) {
-		bitmap->_hasTransparency = false;
-		bitmap->_numTex = ((bitmap->_width + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE) *
-			((bitmap->_height + (BITMAP_TEXTURE_SIZE - 1)) / BITMAP_TEXTURE_SIZE);
-		bitmap->_texIds = new GLuint[bitmap->_numTex * bitmap->_numImages];
-		textures = (GLuint *)bitmap->_texIds;
-		glGenTextures(bitmap->_numTex * bitmap->_numImages, textures);
+		GLuint *textures = (GLuint *)bitmap->_texIds + bitmap->_numTex * pic;
+		glGenTextures(bitmap->_numTex, textures);
 
 		byte *texData = 0;
 		byte *texOut = 0;
@@ -745,63 +884,68 @@ void GfxOpenGL::createBitmap(BitmapData *bitmap) {
 		glPixelStorei(GL_UNPACK_ALIGNMENT, bytes);
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, bitmap->_width);
 
-		for (int pic = 0; pic < bitmap->_numImages; pic++) {
-			if (bitmap->_format == 1 && bitmap->_bpp == 16 && bitmap->_colorFormat != BM_RGB1555) {
-				if (texData == 0)
-					texData = new byte[4 * bitmap->_width * bitmap->_height];
-				// Convert data to 32-bit RGBA format
-				byte *texDataPtr = texData;
-				uint16 *bitmapData = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
-				for (int i = 0; i < bitmap->_width * bitmap->_height; i++, texDataPtr += 4, bitmapData++) {
-					uint16 pixel = *bitmapData;
-					int r = pixel >> 11;
-					texDataPtr[0] = (r << 3) | (r >> 2);
-					int g = (pixel >> 5) & 0x3f;
-					texDataPtr[1] = (g << 2) | (g >> 4);
-					int b = pixel & 0x1f;
-					texDataPtr[2] = (b << 3) | (b >> 2);
-					if (pixel == 0xf81f) { // transparent
-						texDataPtr[3] = 0;
-						bitmap->_hasTransparency = true;
-					} else {
-						texDataPtr[3] = 255;
-					}
+		if (bitmap->_format == 1 && bitmap->_bpp == 16 && bitmap->_colorFormat != BM_RGB1555) {
+			texData = new byte[4 * bitmap->_width * bitmap->_height];
+			// Convert data to 32-bit RGBA format
+			byte *texDataPtr = texData;
+			uint16 *bitmapData = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
+			for (int i = 0; i < bitmap->_width * bitmap->_height; i++, texDataPtr += 4, bitmapData++) {
+				uint16 pixel = *bitmapData;
+				int r = pixel >> 11;
+				texDataPtr[0] = (r << 3) | (r >> 2);
+				int g = (pixel >> 5) & 0x3f;
+				texDataPtr[1] = (g << 2) | (g >> 4);
+				int b = pixel & 0x1f;
+				texDataPtr[2] = (b << 3) | (b >> 2);
+				if (pixel == 0xf81f) { // transparent
+					texDataPtr[3] = 0;
+					bitmap->_hasTransparency = true;
+				} else {
+					texDataPtr[3] = 255;
 				}
-				texOut = texData;
-			} else if (bitmap->_format == 1 && bitmap->_colorFormat == BM_RGB1555) {
-				bitmap->convertToColorFormat(pic, Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
-				texOut = (byte *)bitmap->getImageData(pic).getRawBuffer();
-			} else {
-				texOut = (byte *)bitmap->getImageData(pic).getRawBuffer();
 			}
+			texOut = texData;
+		} else if (bitmap->_format == 1 && bitmap->_colorFormat == BM_RGB1555) {
+			bitmap->convertToColorFormat(pic, Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+			texOut = (byte *)bitmap->getImageData(pic).getRawBuffer();
+		} else {
+			texOut = (byte *)bitmap->getImageData(pic).getRawBuffer();
+		}
 
-			for (int i = 0; i < bitmap->_numTex; i++) {
-				glBindTexture(GL_TEXTURE_2D, textures[bitmap->_numTex * pic + i]);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-				glTexImage2D(GL_TEXTURE_2D, 0, format, BITMAP_TEXTURE_SIZE, BITMAP_TEXTURE_SIZE, 0, format, type, NULL);
-			}
+		for (int i = 0; i < bitmap->_numTex; i++) {
+			glBindTexture(GL_TEXTURE_2D, textures[i]);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+			glTexImage2D(GL_TEXTURE_2D, 0, format, BITMAP_TEXTURE_SIZE, BITMAP_TEXTURE_SIZE, 0, format, type, NULL);
+		}
 
-			int cur_tex_idx = bitmap->_numTex * pic;
+		int cur_tex_idx = 0;
 
-			for (int y = 0; y < bitmap->_height; y += BITMAP_TEXTURE_SIZE) {
-				for (int x = 0; x < bitmap->_width; x += BITMAP_TEXTURE_SIZE) {
-					int width  = (x + BITMAP_TEXTURE_SIZE >= bitmap->_width) ? (bitmap->_width - x) : BITMAP_TEXTURE_SIZE;
-					int height = (y + BITMAP_TEXTURE_SIZE >= bitmap->_height) ? (bitmap->_height - y) : BITMAP_TEXTURE_SIZE;
-					glBindTexture(GL_TEXTURE_2D, textures[cur_tex_idx]);
-					glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type,
-						texOut + (y * bytes * bitmap->_width) + (bytes * x));
-					cur_tex_idx++;
-				}
+		for (int y = 0; y < bitmap->_height; y += BITMAP_TEXTURE_SIZE) {
+			for (int x = 0; x < bitmap->_width; x += BITMAP_TEXTURE_SIZE) {
+				int width  = (x + BITMAP_TEXTURE_SIZE >= bitmap->_width) ? (bitmap->_width - x) : BITMAP_TEXTURE_SIZE;
+				int height = (y + BITMAP_TEXTURE_SIZE >= bitmap->_height) ? (bitmap->_height - y) : BITMAP_TEXTURE_SIZE;
+				glBindTexture(GL_TEXTURE_2D, textures[cur_tex_idx]);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type,
+					texOut + (y * bytes * bitmap->_width) + (bytes * x));
+				cur_tex_idx++;
 			}
 		}
 
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 
 		delete[] texData;
-		bitmap->freeData();
+	}
+}
+
+void GfxOpenGL::destroyBitmapImage(BitmapData *bitmap, int pic) {
+	GLuint *textures = (GLuint *)bitmap->_texIds;
+	if (textures) {
+		textures += bitmap->_numTex * pic;
+		glDeleteTextures(bitmap->_numTex, textures);
+		memset(textures, 0, bitmap->_numTex * sizeof(GLuint));
 	}
 }
 
@@ -842,18 +986,16 @@ void GfxOpenGL::drawBitmap(const Bitmap *bitmap, int dx, int dy, bool initialDra
 		while (frontLayer <= curLayer) {
 			uint32 offset = data->_layers[curLayer]._offset;
 			for (uint32 i = offset; i < offset + data->_layers[curLayer]._numImages; ++i) {
-				glBindTexture(GL_TEXTURE_2D, textures[data->_verts[i]._texid]);
-				glBegin(GL_QUADS);
+				bindQuadTexture(textures[data->_verts[i]._texid]);
 				uint32 ntex = data->_verts[i]._pos * 4;
 				for (uint32 x = 0; x < data->_verts[i]._verts; ++x) {
-					glTexCoord2f(texc[ntex + 2], texc[ntex + 3]);
-					glVertex2f(texc[ntex + 0], texc[ntex + 1]);
+					addQuadVertex(texc[ntex + 0], texc[ntex + 1], texc[ntex + 2], texc[ntex + 3]);
 					ntex += 4;
 				}
-				glEnd();
 			}
 			curLayer--;
 		}
+		flushQuads();
 
 		glDisable(GL_TEXTURE_2D);
 		glDepthMask(GL_TRUE);
@@ -923,20 +1065,15 @@ void GfxOpenGL::drawBitmap(const Bitmap *bitmap, int dx, int dy, bool initialDra
 	for (int y = dy; y < (dy + bitmap->getHeight()); y += BITMAP_TEXTURE_SIZE) {
 		for (int x = dx; x < (dx + bitmap->getWidth()); x += BITMAP_TEXTURE_SIZE) {
 			textures = (GLuint *)bitmap->getTexIds();
-			glBindTexture(GL_TEXTURE_2D, textures[cur_tex_idx]);
-			glBegin(GL_QUADS);
-			glTexCoord2f(0.0f, 0.0f);
-			glVertex2f(x * _scaleW, y * _scaleH);
-			glTexCoord2f(1.0f, 0.0f);
-			glVertex2f((x + BITMAP_TEXTURE_SIZE) * _scaleW, y * _scaleH);
-			glTexCoord2f(1.0f, 1.0f);
-			glVertex2f((x + BITMAP_TEXTURE_SIZE) * _scaleW, (y + BITMAP_TEXTURE_SIZE)  * _scaleH);
-			glTexCoord2f(0.0f, 1.0f);
-			glVertex2f(x * _scaleW, (y + BITMAP_TEXTURE_SIZE) * _scaleH);
-			glEnd();
+			bindQuadTexture(textures[cur_tex_idx]);
+			addQuadVertex(x * _scaleW, y * _scaleH, 0.0f, 0.0f);
+			addQuadVertex((x + BITMAP_TEXTURE_SIZE) * _scaleW, y * _scaleH, 1.0f, 0.0f);
+			addQuadVertex((x + BITMAP_TEXTURE_SIZE) * _scaleW, (y + BITMAP_TEXTURE_SIZE)  * _scaleH, 1.0f, 1.0f);
+			addQuadVertex(x * _scaleW, (y + BITMAP_TEXTURE_SIZE) * _scaleH, 0.0f, 1.0f);
 			cur_tex_idx++;
 		}
 	}
+	flushQuads();
 	glDisable(GL_SCISSOR_TEST);
 	glDisable(GL_TEXTURE_2D);
 	glDisable(GL_BLEND);
@@ -1093,7 +1230,7 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 	if (!userData)
 		error("Could not get font userdata");
 	float size = userData->size * _scaleW;
-	GLuint texture = userData->texture;
+	bindQuadTexture(userData->texture);
 	const Common::String *lines = text->getLines();
 	int numLines = text->getNumLines();
 	for (int j = 0; j < numLines; ++j) {
@@ -1108,23 +1245,17 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 			float z = x + font->getCharStartingCol(character);
 			z *= _scaleW;
 			w *= _scaleH;
-			glBindTexture(GL_TEXTURE_2D, texture);
 			float width = 1 / 16.f;
 			float cx = ((character - 1) % 16) / 16.0f;
 			float cy = ((character - 1) / 16) / 16.0f;
-			glBegin(GL_QUADS);
-			glTexCoord2f(cx, cy);
-			glVertex2f(z, w);
-			glTexCoord2f(cx + width, cy);
-			glVertex2f(z + size, w);
-			glTexCoord2f(cx + width, cy + width);
-			glVertex2f(z + size, w + size);
-			glTexCoord2f(cx, cy + width);
-			glVertex2f(z, w + size);
-			glEnd();
+			addQuadVertex(z, w, cx, cy);
+			addQuadVertex(z + size, w, cx + width, cy);
+			addQuadVertex(z + size, w + size, cx + width, cy + width);
+			addQuadVertex(z, w + size, cx, cy + width);
 			x += font->getCharWidth(character);
 		}
 	}
+	flushQuads();
 
 	glColor3f(1, 1, 1);
 
@@ -1191,6 +1322,7 @@ void GfxOpenGL::createMaterial(Texture *material, const char *data, const CMap *
 void GfxOpenGL::selectMaterial(const Texture *material) {
 	GLuint *textures = (GLuint *)material->_texture;
 	glBindTexture(GL_TEXTURE_2D, textures[0]);
+	_frameStats.stateChanges++;
 
 	if (material->_hasAlpha && g_grim->getGameType() == GType_MONKEY4) {
 		glEnable(GL_BLEND);
@@ -1310,20 +1442,15 @@ void GfxOpenGL::drawMovieFrame(int offsetX, int offsetY) {
 	int curTexIdx = 0;
 	for (int y = 0; y < _smushHeight; y += (int)(BITMAP_TEXTURE_SIZE * _scaleH)) {
 		for (int x = 0; x < _smushWidth; x += (int)(BITMAP_TEXTURE_SIZE * _scaleW)) {
-			glBindTexture(GL_TEXTURE_2D, _smushTexIds[curTexIdx]);
-			glBegin(GL_QUADS);
-			glTexCoord2f(0, 0);
-			glVertex2f(x + offsetX, y + offsetY);
-			glTexCoord2f(1.0f, 0.0f);
-			glVertex2f(x + offsetX + BITMAP_TEXTURE_SIZE * _scaleW, y + offsetY);
-			glTexCoord2f(1.0f, 1.0f);
-			glVertex2f(x + offsetX + BITMAP_TEXTURE_SIZE * _scaleW, y + offsetY + BITMAP_TEXTURE_SIZE * _scaleH);
-			glTexCoord2f(0.0f, 1.0f);
-			glVertex2f(x + offsetX, y + offsetY + BITMAP_TEXTURE_SIZE * _scaleH);
-			glEnd();
+			bindQuadTexture(_smushTexIds[curTexIdx]);
+			addQuadVertex(x + offsetX, y + offsetY, 0.0f, 0.0f);
+			addQuadVertex(x + offsetX + BITMAP_TEXTURE_SIZE * _scaleW, y + offsetY, 1.0f, 0.0f);
+			addQuadVertex(x + offsetX + BITMAP_TEXTURE_SIZE * _scaleW, y + offsetY + BITMAP_TEXTURE_SIZE * _scaleH, 1.0f, 1.0f);
+			addQuadVertex(x + offsetX, y + offsetY + BITMAP_TEXTURE_SIZE * _scaleH, 0.0f, 1.0f);
 			curTexIdx++;
 		}
 	}
+	flushQuads();
 
 	glDisable(GL_SCISSOR_TEST);
 	glDisable(GL_TEXTURE_2D);
@@ -1485,6 +1612,7 @@ void GfxOpenGL::dimRegion(int x, int yReal, int w, int h, float level) {
 		glEnable(GL_TEXTURE_2D);
 		glBindTexture(GL_TEXTURE_2D, texture);
 
+		_frameStats.drawCalls++;
 		glBegin(GL_QUADS);
 		glTexCoord2f(0, 0);
 		glVertex2f(x, y);
@@ -1571,6 +1699,7 @@ void GfxOpenGL::irisAroundRegion(int x1, int y1, int x2, int y2) {
 
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glVertexPointer(2, GL_FLOAT, 0, points);
+	_frameStats.drawCalls++;
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 10);
 	glDisableClientState(GL_VERTEX_ARRAY);
 
@@ -1600,6 +1729,7 @@ void GfxOpenGL::drawRectangle(const PrimitiveObject *primitive) {
 	glColor3ub(color.getRed(), color.getGreen(), color.getBlue());
 
 	if (primitive->isFilled()) {
+		_frameStats.drawCalls++;
 		glBegin(GL_QUADS);
 		glVertex2f(x1, y1);
 		glVertex2f(x2 + 1, y1);
@@ -1607,6 +1737,7 @@ void GfxOpenGL::drawRectangle(const PrimitiveObject *primitive) {
 		glVertex2f(x1, y2 + 1);
 		glEnd();
 	} else {
+		_frameStats.drawCalls++;
 		glBegin(GL_QUADS);
 
 		// top line
@@ -1666,6 +1797,7 @@ void GfxOpenGL::drawLine(const PrimitiveObject *primitive) {
 
 	glLineWidth(_scaleW);
 
+	_frameStats.drawCalls++;
 	glBegin(GL_LINES);
 	glVertex2f(x1, y1);
 	glVertex2f(x2, y2);
@@ -1702,11 +1834,13 @@ void GfxOpenGL::drawPolygon(const PrimitiveObject *primitive) {
 
 	glColor3ub(color.getRed(), color.getGreen(), color.getBlue());
 
+	_frameStats.drawCalls++;
 	glBegin(GL_LINES);
 	glVertex2f(x1, y1);
 	glVertex2f(x2, y2);
 	glEnd();
 
+	_frameStats.drawCalls++;
 	glBegin(GL_LINES);
 	glVertex2f(x3, y3);
 	glVertex2f(x4, y4);
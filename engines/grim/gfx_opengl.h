@@ -25,6 +25,8 @@
 
 #include "engines/grim/gfx_base.h"
 
+#include "common/array.h"
+
 #ifdef USE_OPENGL
 
 #if defined (SDL_BACKEND) && !defined(__amigaos4__)
@@ -76,10 +78,12 @@ public:
 	void translateViewpointStart();
 	void translateViewpoint(const Math::Vector3d &vec);
 	void rotateViewpoint(const Math::Angle &angle, const Math::Vector3d &axis);
+	void transformViewpoint(const Math::Matrix4 &matrix);
 	void translateViewpointFinish();
 
 	void drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face);
 	void drawModelFace(const MeshFace *face, float *vertices, float *vertNormals, float *textureVerts);
+	void drawMesh(const Mesh *mesh);
 	void drawSprite(const Sprite *sprite);
 
 	void enableLights();
@@ -92,6 +96,8 @@ public:
 	void destroyMaterial(Texture *material);
 
 	void createBitmap(BitmapData *bitmap);
+	void createBitmapImage(BitmapData *bitmap, int pic);
+	void destroyBitmapImage(BitmapData *bitmap, int pic);
 	void drawBitmap(const Bitmap *bitmap, int x, int y, bool initialDraw = true);
 	void destroyBitmap(BitmapData *bitmap);
 
@@ -125,6 +131,11 @@ public:
 protected:
 	void drawDepthBitmap(int x, int y, int w, int h, char *data);
 private:
+	void bindQuadTexture(GLuint texture);
+	void addQuadVertex(float x, float y, float s, float t);
+	void flushQuads();
+	const byte *getEMIColors(const EMIModel *model);
+
 	GLuint _emergFont;
 	int _smushNumTex;
 	GLuint *_smushTexIds;
@@ -137,6 +148,15 @@ private:
 	GLuint _dimFragProgram;
 	GLint _maxLights;
 	float _alpha;
+
+	// Textured 2D quads sharing a texture, drawn with a single call
+	Common::Array<float> _quadVerts; // x, y, s and t of every vertex
+	GLuint _quadTexture;
+
+	// The vertex colors of the last EMI model drawn dimmed or translucent
+	Common::Array<byte> _emiColors;
+	const EMIModel *_emiColorsModel;
+	float _emiColorsDim, _emiColorsAlpha;
 };
 
 } // end of namespace Grim
@@ -56,12 +56,16 @@ public:
 		_height = 0;
 	}
 	~BlitImage() {
+		clear();
+	}
+	void clear() {
 		Line *temp = _lines;
 		while (temp != NULL) {
 			_lines = temp->next;
 			delete temp;
 			temp = _lines;
 		}
+		_last = NULL;
 	}
 	void create(const Graphics::PixelBuffer &buf, uint32 transparency, int x, int y, int width, int height) {
 		Graphics::PixelBuffer srcBuf = buf;
@@ -230,14 +234,57 @@ TGLint tgluProject(TGLfloat objx, TGLfloat objy, TGLfloat objz, const TGLfloat m
 	return TGL_TRUE;
 }
 
+/**
+ * The font data converted to the screen format for one text color. The
+ * glyphs keep the layout they have in the font data, so text lines are
+ * composed by copying pixels.
+ */
+struct FontAtlas {
+	uint32 color;
+	byte *pixels;
+	FontAtlas *next;
+};
+
+/**
+ * A rendered line of text. Identical lines are shared between text objects,
+ * and a few unused ones are kept around, since subtitles and dialog menus
+ * show the same lines over and over again.
+ */
+struct CachedTextLine {
+	const Font *font;
+	uint32 color;
+	Common::String text;
+	byte *data;
+	int width, height;
+	int refCount;
+	uint32 lastUse;
+};
+
+static const uint kMaxUnusedTextLines = 16;
+static const uint32 kTextTransparentColor = 0xf81f;
+
+// Past this many damaged rectangles, just use their bounding box
+static const uint kMaxDamageRects = 16;
+
 GfxTinyGL::GfxTinyGL() {
 	g_driver = this;
 	_zb = NULL;
 	_storedDisplay = NULL;
 	_alpha = 1.f;
+	_textCacheClock = 0;
+	_backgroundPending = false;
+	_backgroundValid = false;
+	_backgroundDepth = NULL;
+	_movieFrameId = 0;
+	_fullDamage = true;
 }
 
 GfxTinyGL::~GfxTinyGL() {
+	for (uint i = 0; i < _textCache.size(); ++i) {
+		delete[] _textCache[i]->data;
+		delete _textCache[i];
+	}
+	delete[] _backgroundDepth;
 	if (_zb) {
 		TinyGL::glClose();
 		ZB_close(_zb);
@@ -266,6 +313,8 @@ byte *GfxTinyGL::setupScreen(int screenW, int screenH, bool fullscreen) {
 	_screenSize = _gameWidth * _gameHeight * _pixelFormat.bytesPerPixel;
 	_storedDisplay.create(_pixelFormat, _gameWidth * _gameHeight, DisposeAfterUse::YES);
 	_storedDisplay.clear(_gameWidth * _gameHeight);
+	_backgroundPixels.create(_pixelFormat, _gameWidth * _gameHeight, DisposeAfterUse::YES);
+	_backgroundDepth = new unsigned int[_gameWidth * _gameHeight];
 
 	_currentShadowArray = NULL;
 
@@ -310,28 +359,164 @@ void GfxTinyGL::positionCamera(const Math::Vector3d &pos, const Math::Vector3d &
 }
 
 void GfxTinyGL::clearScreen() {
+	// The clear, and the bitmaps and movie frame drawn after it, are only
+	// done in resolveBackground(), once something else is drawn.
+	_pendingBackground.resize(0);
+	_backgroundPending = true;
+}
+
+bool GfxTinyGL::BackgroundDraw::operator==(const BackgroundDraw &other) const {
+	return data == other.data && image == other.image && x == other.x && y == other.y &&
+	       initialDraw == other.initialDraw && renderBitmaps == other.renderBitmaps &&
+	       renderZBitmaps == other.renderZBitmaps && dimLevel == other.dimLevel &&
+	       movieFrame == other.movieFrame;
+}
+
+void GfxTinyGL::resolveBackground() {
+	if (!_backgroundPending)
+		return;
+	_backgroundPending = false;
+
+	// Actors drawn before the clear may still be on the screen
+	addDrawnArea();
+
+	bool same = _backgroundValid && _pendingBackground.size() == _background.size();
+	for (uint i = 0; same && i < _background.size(); ++i) {
+		same = _pendingBackground[i] == _background[i];
+	}
+
+	if (same) {
+		for (uint i = 0; i < _overdrawn.size(); ++i) {
+			restoreBackground(_overdrawn[i]);
+			addRect(_damage, _overdrawn[i]);
+		}
+		_overdrawn.resize(0);
+		return;
+	}
+
 	_zb->pbuf.clear(_screenSize);
 	memset(_zb->zbuf, 0, _gameWidth * _gameHeight * sizeof(unsigned int));
+	for (uint i = 0; i < _pendingBackground.size(); ++i) {
+		const BackgroundDraw &draw = _pendingBackground[i];
+		if (draw.data) {
+			drawBitmapNow(draw.data, draw.image, draw.x, draw.y, draw.initialDraw);
+		} else {
+			drawMovieFrameNow(draw.x, draw.y);
+		}
+	}
+
+	_backgroundPixels.copyBuffer(0, _gameWidth * _gameHeight, _zb->pbuf);
+	memcpy(_backgroundDepth, _zb->zbuf, _gameWidth * _gameHeight * sizeof(unsigned int));
+	_background = _pendingBackground;
+	_backgroundValid = true;
+	_overdrawn.resize(0);
+	_fullDamage = true;
+}
+
+void GfxTinyGL::restoreBackground(const Common::Rect &rect) {
+	const int width = rect.width();
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		const int offset = y * _gameWidth + rect.left;
+		_zb->pbuf.copyBuffer(offset, offset, width, _backgroundPixels);
+		memcpy(_zb->zbuf + offset, _backgroundDepth + offset, width * sizeof(unsigned int));
+	}
+}
+
+void GfxTinyGL::addRect(Common::Array<Common::Rect> &rects, const Common::Rect &rect) const {
+	Common::Rect r(rect);
+	r.clip(Common::Rect(_gameWidth, _gameHeight));
+	if (r.isEmpty())
+		return;
+
+	for (uint i = 0; i < rects.size(); ++i) {
+		if (rects[i].contains(r))
+			return;
+	}
+	for (uint i = 0; i < rects.size();) {
+		if (r.contains(rects[i])) {
+			rects.remove_at(i);
+		} else {
+			++i;
+		}
+	}
+
+	if (rects.size() >= kMaxDamageRects) {
+		for (uint i = 0; i < rects.size(); ++i) {
+			r.extend(rects[i]);
+		}
+		rects.resize(0);
+	}
+	rects.push_back(r);
+}
+
+void GfxTinyGL::addDamage(const Common::Rect &rect) {
+	addRect(_overdrawn, rect);
+	addRect(_damage, rect);
+}
+
+Common::Rect GfxTinyGL::getDrawnArea() {
+	Common::Rect area;
+	if (_zb->drawn_x1 <= _zb->drawn_x2 && _zb->drawn_y1 <= _zb->drawn_y2) {
+		area = Common::Rect(_zb->drawn_x1, _zb->drawn_y1, _zb->drawn_x2 + 1, _zb->drawn_y2 + 1);
+	}
+	TinyGL::ZB_resetDrawnArea(_zb);
+	return area;
+}
+
+void GfxTinyGL::addDrawnArea() {
+	Common::Rect area = getDrawnArea();
+	if (area.isEmpty())
+		return;
+
+	if (_zb->pbuf.getRawBuffer() == _zb->buffers[0].pbuf) {
+		addDamage(area);
+	} else if (_cleanBufferArea.isEmpty()) {
+		_cleanBufferArea = area;
+	} else {
+		_cleanBufferArea.extend(area);
+	}
+}
+
+void GfxTinyGL::invalidateScreen() {
+	_backgroundValid = false;
+	_fullDamage = true;
 }
 
 void GfxTinyGL::flipBuffer() {
-	g_system->updateScreen();
+	resolveBackground();
+	addDrawnArea();
+
+	if (_fullDamage) {
+		g_system->updateScreen();
+	} else if (!_damage.empty()) {
+		g_system->updateScreenRects(&_damage[0], _damage.size());
+	}
+	_damage.resize(0);
+	_fullDamage = false;
+
+	finishFrameStats();
 }
 
 void GfxTinyGL::selectScreenBuffer() {
+	addDrawnArea();
 	TinyGL::ZB_selectScreenBuffer(_zb);
 }
 
 void GfxTinyGL::selectCleanBuffer() {
+	resolveBackground();
+	addDrawnArea();
 	TinyGL::ZB_selectOffscreenBuffer(_zb);
 }
 
 void GfxTinyGL::clearCleanBuffer() {
 	TinyGL::ZB_clearOffscreenBuffer(_zb);
+	_cleanBufferArea = Common::Rect();
 }
 
 void GfxTinyGL::drawCleanBuffer() {
+	resolveBackground();
 	TinyGL::ZB_blitOffscreenBuffer(_zb);
+	addDamage(_cleanBufferArea);
 }
 
 bool GfxTinyGL::isHardwareAccelerated() {
@@ -475,6 +660,7 @@ void GfxTinyGL::getBoundingBoxPos(const Mesh *model, int *x1, int *y1, int *x2,
 
 void GfxTinyGL::startActorDraw(const Math::Vector3d &pos, float scale, const Math::Quaternion &quat,
 	                             const bool inOverworld, const float alpha) {
+	resolveBackground();
 	tglEnable(TGL_TEXTURE_2D);
 	tglMatrixMode(TGL_PROJECTION);
 	tglPushMatrix();
@@ -557,9 +743,12 @@ void GfxTinyGL::finishActorDraw() {
 			WRITE_LE_UINT16(dst + _gameWidth * y + g_winX2, c);
 		}
 	}*/
+
+	addDrawnArea();
 }
 
 void GfxTinyGL::drawShadowPlanes() {
+	resolveBackground();
 	tglEnable(TGL_SHADOW_MASK_MODE);
 	if (!_currentShadowArray->shadowMask) {
 		_currentShadowArray->shadowMask = new byte[_gameWidth * _gameHeight];
@@ -592,6 +781,7 @@ void GfxTinyGL::clearShadowMode() {
 }
 
 void GfxTinyGL::set3DMode() {
+	resolveBackground();
 	tglMatrixMode(TGL_MODELVIEW);
 	tglEnable(TGL_DEPTH_TEST);
 }
@@ -642,6 +832,8 @@ void GfxTinyGL::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face)
 	}
 
 	tglEnd();
+	_frameStats.drawCalls++;
+	_frameStats.faces += face->_faceLength;
 	tglEnable(TGL_TEXTURE_2D);
 	tglEnable(TGL_DEPTH_TEST);
 	tglEnable(TGL_ALPHA_TEST);
@@ -659,6 +851,8 @@ void GfxTinyGL::drawModelFace(const MeshFace *face, float *vertices, float *vert
 		tglVertex3fv(vertices + 3 * face->_vertices[i]);
 	}
 	tglEnd();
+	_frameStats.drawCalls++;
+	_frameStats.faces++;
 }
 
 void GfxTinyGL::drawSprite(const Sprite *sprite) {
@@ -718,6 +912,13 @@ void GfxTinyGL::rotateViewpoint(const Math::Angle &angle, const Math::Vector3d &
 	tglRotatef(angle.getDegrees(), axis.x(), axis.y(), axis.z());
 }
 
+void GfxTinyGL::transformViewpoint(const Math::Matrix4 &matrix) {
+	// Math::Matrix4 is stored by rows, TinyGL wants it by columns
+	Math::Matrix4 m = matrix;
+	m.transpose();
+	tglMultMatrixf(m.getData());
+}
+
 void GfxTinyGL::translateViewpointFinish() {
 	tglPopMatrix();
 }
@@ -781,31 +982,44 @@ void GfxTinyGL::turnOffLight(int lightId) {
 }
 
 void GfxTinyGL::createBitmap(BitmapData *bitmap) {
+	// A new bitmap may be at the address of one in the recorded background
+	_backgroundValid = false;
 	if (bitmap->_format == 1) {
-		bitmap->convertToColorFormat(_pixelFormat);
+		bitmap->_texIds = (void *)new BlitImage[bitmap->_numImages];
 	}
+
+	for (int pic = 0; pic < bitmap->_numImages; pic++) {
+		if (bitmap->hasImageData(pic))
+			createBitmapImage(bitmap, pic);
+	}
+}
+
+void GfxTinyGL::createBitmapImage(BitmapData *bitmap, int pic) {
 	if (bitmap->_format != 1) {
-		for (int pic = 0; pic < bitmap->_numImages; pic++) {
-			uint32 *buf = new uint32[bitmap->_width * bitmap->_height];
-			uint16 *bufPtr = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
-			for (int i = 0; i < (bitmap->_width * bitmap->_height); i++) {
-				uint16 val = READ_LE_UINT16(bufPtr + i);
-				// fix the value if it is incorrectly set to the bitmap transparency color
-				if (val == 0xf81f) {
-					val = 0;
-				}
-				buf[i] = ((uint32) val) * 0x10000 / 100 / (0x10000 - val) << 14;
+		uint32 *buf = new uint32[bitmap->_width * bitmap->_height];
+		uint16 *bufPtr = reinterpret_cast<uint16 *>(bitmap->getImageData(pic).getRawBuffer());
+		for (int i = 0; i < (bitmap->_width * bitmap->_height); i++) {
+			uint16 val = READ_LE_UINT16(bufPtr + i);
+			// fix the value if it is incorrectly set to the bitmap transparency color
+			if (val == 0xf81f) {
+				val = 0;
 			}
-			delete[] bufPtr;
-			bitmap->_data[pic] = Graphics::PixelBuffer(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), (byte*)buf);
+			buf[i] = ((uint32) val) * 0x10000 / 100 / (0x10000 - val) << 14;
 		}
+		delete[] bufPtr;
+		bitmap->_data[pic] = Graphics::PixelBuffer(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), (byte*)buf);
 	} else {
-		BlitImage *imgs = new BlitImage[bitmap->_numImages];
-		bitmap->_texIds = (void *)imgs;
+		bitmap->convertToColorFormat(pic, _pixelFormat);
+		BlitImage *imgs = (BlitImage *)bitmap->_texIds;
+		imgs[pic].create(bitmap->getImageData(pic), 0xf81f, bitmap->_x, bitmap->_y, bitmap->_width, bitmap->_height);
+	}
+}
 
-		for (int i = 0; i < bitmap->_numImages; ++i) {
-			imgs[i].create(bitmap->getImageData(i), 0xf81f, bitmap->_x, bitmap->_y, bitmap->_width, bitmap->_height);
-		}
+void GfxTinyGL::destroyBitmapImage(BitmapData *bitmap, int pic) {
+	resolveBackground();
+	if (bitmap->_format == 1) {
+		BlitImage *imgs = (BlitImage *)bitmap->_texIds;
+		imgs[pic].clear();
 	}
 }
 
@@ -898,14 +1112,39 @@ void GfxTinyGL::blit(const Graphics::PixelFormat &format, BlitImage *image, byte
 }
 
 void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, bool initialDraw) {
+	const int image = bitmap->getActiveImage() - 1;
+	if (_backgroundPending) {
+		BackgroundDraw draw;
+		draw.data = bitmap->_data;
+		draw.image = image;
+		draw.x = x;
+		draw.y = y;
+		draw.initialDraw = initialDraw;
+		draw.renderBitmaps = _renderBitmaps;
+		draw.renderZBitmaps = _renderZBitmaps;
+		draw.dimLevel = _dimLevel;
+		draw.movieFrame = 0;
+		_pendingBackground.push_back(draw);
+		return;
+	}
+
+	addDamage(drawBitmapNow(bitmap->_data, image, x, y, initialDraw));
+}
 
+static Common::Rect makeRect(int x, int y, int width, int height) {
+	if (width <= 0 || height <= 0)
+		return Common::Rect();
+	return Common::Rect(x, y, x + width, y + height);
+}
+
+Common::Rect GfxTinyGL::drawBitmapNow(const BitmapData *data, int image, int x, int y, bool initialDraw) {
 	// PS2 EMI uses a TGA for it's splash-screen, avoid using the following
 	// code for drawing that (as it has no tiles).
-	if (g_grim->getGameType() == GType_MONKEY4 && bitmap->_data->_numImages > 1) {
+	if (g_grim->getGameType() == GType_MONKEY4 && data->_numImages > 1) {
 		// tglColor3f(1.0f - _dimLevel, 1.0f - _dimLevel, 1.0f  - _dimLevel);
 
-		BitmapData *data = bitmap->_data;
 		float *texc = data->_texc;
+		Common::Rect area;
 
 		int curLayer, frontLayer;
 		if (initialDraw) {
@@ -915,7 +1154,7 @@ void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, bool initialDraw)
 			frontLayer = 0;
 		}
 
-		BlitImage *b = (BlitImage *)bitmap->getTexIds();
+		BlitImage *b = (BlitImage *)data->_texIds;
 
 		while (frontLayer <= curLayer) {
 			uint32 offset = data->_layers[curLayer]._offset;
@@ -929,39 +1168,51 @@ void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, bool initialDraw)
 					int dy1 = round((1 - texc[ntex+1]) * _screenHeight) / 2;
 					int dx2 = round((texc[ntex+8] + 1) * _screenWidth) / 2;
 					int dy2 = round((1 - texc[ntex+9]) * _screenHeight) / 2;
-					int srcX = round(texc[ntex+2] * bitmap->getWidth());
-					int srcY = round(texc[ntex+3] * bitmap->getHeight());
+					int srcX = round(texc[ntex+2] * data->_width);
+					int srcY = round(texc[ntex+3] * data->_height);
+					const Graphics::PixelBuffer &src = data->getImageData(texId);
 
-					blit(bitmap->getPixelFormat(texId), &b[texId], _zb->pbuf.getRawBuffer(), bitmap->getData(texId).getRawBuffer(),
+					blit(src.getFormat(), &b[texId], _zb->pbuf.getRawBuffer(), src.getRawBuffer(),
 							x + dx1, y + dy1, srcX, srcY, dx2 - dx1, dy2 - dy1, b[texId]._width, b[texId]._height, !initialDraw);
+					Common::Rect r = makeRect(x + dx1, y + dy1, dx2 - dx1, dy2 - dy1);
+					if (area.isEmpty()) {
+						area = r;
+					} else if (!r.isEmpty()) {
+						area.extend(r);
+					}
 					ntex += 16;
 				}
 			}
 			curLayer--;
 		}
 
-		return;
+		return area;
 	}
 
-	int format = bitmap->getFormat();
+	int format = data->_format;
 	if ((format == 1 && !_renderBitmaps) || (format == 5 && !_renderZBitmaps)) {
-		return;
+		return Common::Rect();
 	}
 
-	assert(bitmap->getActiveImage() > 0);
-	const int num = bitmap->getActiveImage() - 1;
+	assert(image >= 0);
+	const Graphics::PixelBuffer &src = data->getImageData(image);
 
-	BlitImage *b = (BlitImage *)bitmap->getTexIds();
+	BlitImage *b = (BlitImage *)data->_texIds;
 
-	if (bitmap->getFormat() == 1)
-		blit(bitmap->getPixelFormat(num), &b[num], (byte *)_zb->pbuf.getRawBuffer(), (byte *)bitmap->getData(num).getRawBuffer(),
-			x, y, bitmap->getWidth(), bitmap->getHeight(), true);
+	if (format == 1)
+		blit(src.getFormat(), &b[image], (byte *)_zb->pbuf.getRawBuffer(), (byte *)src.getRawBuffer(),
+			x, y, data->_width, data->_height, true);
 	else
-		blit(bitmap->getPixelFormat(num), NULL, (byte *)_zb->zbuf, (byte *)bitmap->getData(num).getRawBuffer(),
-			x, y, bitmap->getWidth(), bitmap->getHeight(), false);
+		blit(src.getFormat(), NULL, (byte *)_zb->zbuf, (byte *)src.getRawBuffer(),
+			x, y, data->_width, data->_height, false);
+	return makeRect(x, y, data->_width, data->_height);
 }
 
 void GfxTinyGL::destroyBitmap(BitmapData *bitmap) {
+	// The bitmap may be part of the recorded background
+	resolveBackground();
+	_backgroundValid = false;
+
 	for (int pic = 0; pic < bitmap->_numImages; pic++) {
 		if (bitmap->_data)
 			bitmap->_data[pic].free();
@@ -969,15 +1220,168 @@ void GfxTinyGL::destroyBitmap(BitmapData *bitmap) {
 	delete[] (BlitImage*)bitmap->_texIds;
 }
 
+static const byte *getFontAtlas(const Font *font, uint32 color, const Graphics::PixelFormat &format) {
+	FontAtlas *atlas = (FontAtlas *)const_cast<void *>(font->getUserData());
+	for (FontAtlas *a = atlas; a; a = a->next) {
+		if (a->color == color)
+			return a->pixels;
+	}
+
+	Graphics::PixelBuffer buf(format, font->getDataSize(), DisposeAfterUse::NO);
+	const byte *data = font->getFontData();
+	for (uint32 i = 0; i < font->getDataSize(); ++i) {
+		if (data[i] == 0x80) {
+			buf.setPixelAt(i, 0);
+		} else if (data[i] == 0xFF) {
+			buf.setPixelAt(i, color);
+		} else {
+			buf.setPixelAt(i, kTextTransparentColor);
+		}
+	}
+
+	FontAtlas *a = new FontAtlas();
+	a->color = color;
+	a->pixels = buf.getRawBuffer();
+	a->next = atlas;
+	const_cast<Font *>(font)->setUserData(a);
+	return a->pixels;
+}
+
+template<class T>
+static void composeTextLine(T *dst, const T *atlas, const Font *font, const Common::String &text, int width, int height) {
+	const T transparent = kTextTransparentColor;
+	for (int i = 0; i < width * height; i++) {
+		dst[i] = transparent;
+	}
+
+	int startOffset = 0;
+	for (unsigned int d = 0; d < text.size(); d++) {
+		int ch = text[d];
+		int8 startingLine = font->getCharStartingLine(ch) + font->getBaseOffsetY();
+		int32 charDataWidth = font->getCharDataWidth(ch);
+		int32 charDataHeight = font->getCharDataHeight(ch);
+		int8 startingCol = font->getCharStartingCol(ch);
+		const T *glyph = atlas + font->getCharOffset(ch);
+		for (int line = 0; line < charDataHeight; line++) {
+			T *row = dst + startOffset + (width * (line + startingLine)) + startingCol;
+			const T *src = glyph + charDataWidth * line;
+			// Where glyphs overlap, the first one drawn wins
+			for (int r = 0; r < charDataWidth; r++) {
+				if (row[r] == transparent && src[r] != transparent)
+					row[r] = src[r];
+			}
+			if (line + startingLine >= height)
+				break;
+		}
+		startOffset += font->getCharWidth(ch);
+	}
+}
+
 void GfxTinyGL::createFont(Font *font) {
 }
 
 void GfxTinyGL::destroyFont(Font *font) {
+	FontAtlas *atlas = (FontAtlas *)const_cast<void *>(font->getUserData());
+	while (atlas) {
+		FontAtlas *next = atlas->next;
+		delete[] atlas->pixels;
+		delete atlas;
+		atlas = next;
+	}
+	font->setUserData(NULL);
+
+	// Lines still used by a text object are freed when it is destroyed
+	for (uint i = 0; i < _textCache.size(); ) {
+		CachedTextLine *line = _textCache[i];
+		if (line->font != font) {
+			++i;
+		} else if (line->refCount > 0) {
+			line->font = NULL;
+			++i;
+		} else {
+			delete[] line->data;
+			delete line;
+			_textCache.remove_at(i);
+		}
+	}
+}
+
+CachedTextLine *GfxTinyGL::getTextLine(const Font *font, uint32 color, const Common::String &text) {
+	++_textCacheClock;
+	for (uint i = 0; i < _textCache.size(); ++i) {
+		CachedTextLine *line = _textCache[i];
+		if (line->font == font && line->color == color && line->text == text) {
+			++line->refCount;
+			line->lastUse = _textCacheClock;
+			return line;
+		}
+	}
+
+	CachedTextLine *line = new CachedTextLine();
+	line->font = font;
+	line->color = color;
+	line->text = text;
+	line->width = font->getStringLength(text) + 1;
+	line->height = font->getHeight();
+	line->refCount = 1;
+	line->lastUse = _textCacheClock;
+
+	const byte *atlas = getFontAtlas(font, color, _pixelFormat);
+	line->data = new byte[line->width * line->height * _pixelFormat.bytesPerPixel];
+	if (_pixelFormat.bytesPerPixel == 2) {
+		composeTextLine<uint16>((uint16 *)line->data, (const uint16 *)atlas, font, text, line->width, line->height);
+	} else {
+		composeTextLine<uint32>((uint32 *)line->data, (const uint32 *)atlas, font, text, line->width, line->height);
+	}
+
+	_textCache.push_back(line);
+	return line;
+}
+
+void GfxTinyGL::releaseTextLine(CachedTextLine *line) {
+	--line->refCount;
+	if (line->refCount == 0 && !line->font) {
+		// Its font is gone, it can not be used again
+		for (uint i = 0; i < _textCache.size(); ++i) {
+			if (_textCache[i] == line) {
+				_textCache.remove_at(i);
+				break;
+			}
+		}
+		delete[] line->data;
+		delete line;
+		return;
+	}
+	trimTextCache();
+}
+
+void GfxTinyGL::trimTextCache() {
+	uint unused = 0;
+	for (uint i = 0; i < _textCache.size(); ++i) {
+		if (_textCache[i]->refCount == 0)
+			++unused;
+	}
+
+	while (unused > kMaxUnusedTextLines) {
+		uint oldest = 0;
+		bool found = false;
+		for (uint i = 0; i < _textCache.size(); ++i) {
+			CachedTextLine *line = _textCache[i];
+			if (line->refCount == 0 && (!found || line->lastUse < _textCache[oldest]->lastUse)) {
+				oldest = i;
+				found = true;
+			}
+		}
+		delete[] _textCache[oldest]->data;
+		delete _textCache[oldest];
+		_textCache.remove_at(oldest);
+		--unused;
+	}
 }
 
 struct TextObjectData {
-	byte *data;
-	int width, height, x, y;
+	CachedTextLine *line;
+	int x, y;
 };
 
 void GfxTinyGL::createTextObject(TextObject *text) {
@@ -987,63 +1391,13 @@ void GfxTinyGL::createTextObject(TextObject *text) {
 	const Color &fgColor = text->getFGColor();
 	TextObjectData *userData = new TextObjectData[numLines];
 	text->setUserData(userData);
-	for (int j = 0; j < numLines; j++) {
-		const Common::String &currentLine = lines[j];
-
-		int width = font->getStringLength(currentLine) + 1;
-		int height = font->getHeight();
-
-		uint8 *_textBitmap = new uint8[height * width];
-		memset(_textBitmap, 0, height * width);
-
-		// Fill bitmap
-		int startOffset = 0;
-		for (unsigned int d = 0; d < currentLine.size(); d++) {
-			int ch = currentLine[d];
-			int8 startingLine = font->getCharStartingLine(ch) + font->getBaseOffsetY();
-			int32 charDataWidth = font->getCharDataWidth(ch);
-			int32 charWidth = font->getCharWidth(ch);
-			int8 startingCol = font->getCharStartingCol(ch);
-			for (int line = 0; line < font->getCharDataHeight(ch); line++) {
-				int offset = startOffset + (width * (line + startingLine));
-				for (int r = 0; r < charDataWidth; r++) {
-					const byte pixel = *(font->getCharData(ch) + r + (charDataWidth * line));
-					byte *dst = _textBitmap + offset + startingCol + r;
-					if (*dst == 0 && pixel != 0)
-						_textBitmap[offset + startingCol + r] = pixel;
-				}
-				if (line + startingLine >= font->getHeight())
-					break;
-			}
-			startOffset += charWidth;
-		}
 
-		Graphics::PixelBuffer buf(_pixelFormat, width * height, DisposeAfterUse::NO);
-
-		uint8 *bitmapData = _textBitmap;
-		uint8 r = fgColor.getRed();
-		uint8 g = fgColor.getGreen();
-		uint8 b = fgColor.getBlue();
-		uint32 color = _zb->cmode.RGBToColor(r, g, b);
-
-		if (color == 0xf81f)
-			color = 0xf81e;
-
-		int txData = 0;
-		for (int i = 0; i < width * height; i++, txData++, bitmapData++) {
-			byte pixel = *bitmapData;
-			if (pixel == 0x00) {
-				buf.setPixelAt(txData, 0xf81f);
-			} else if (pixel == 0x80) {
-				buf.setPixelAt(txData, 0);
-			} else if (pixel == 0xFF) {
-				buf.setPixelAt(txData, color);
-			}
-		}
+	uint32 color = _zb->cmode.RGBToColor(fgColor.getRed(), fgColor.getGreen(), fgColor.getBlue());
+	if (color == kTextTransparentColor)
+		color = 0xf81e;
 
-		userData[j].width = width;
-		userData[j].height = height;
-		userData[j].data = buf.getRawBuffer();
+	for (int j = 0; j < numLines; j++) {
+		userData[j].line = getTextLine(font, color, lines[j]);
 		userData[j].x = text->getLineX(j);
 		userData[j].y = text->getLineY(j);
 
@@ -1052,8 +1406,6 @@ void GfxTinyGL::createTextObject(TextObject *text) {
 			if (userData[j].y < 0)
 				userData[j].y = 0;
 		}
-
-		delete[] _textBitmap;
 	}
 }
 
@@ -1062,7 +1414,10 @@ void GfxTinyGL::drawTextObject(const TextObject *text) {
 	if (userData) {
 		int numLines = text->getNumLines();
 		for (int i = 0; i < numLines; ++i) {
-			blit(_pixelFormat, NULL, (byte *)_zb->pbuf.getRawBuffer(), userData[i].data, userData[i].x, userData[i].y, userData[i].width, userData[i].height, true);
+			const CachedTextLine *line = userData[i].line;
+			resolveBackground();
+			blit(_pixelFormat, NULL, (byte *)_zb->pbuf.getRawBuffer(), line->data, userData[i].x, userData[i].y, line->width, line->height, true);
+			addDamage(makeRect(userData[i].x, userData[i].y, line->width, line->height));
 		}
 	}
 }
@@ -1072,7 +1427,7 @@ void GfxTinyGL::destroyTextObject(TextObject *text) {
 	if (userData) {
 		int numLines = text->getNumLines();
 		for (int i = 0; i < numLines; ++i) {
-			delete[] userData[i].data;
+			releaseTextLine(userData[i].line);
 		}
 		delete[] userData;
 	}
@@ -1148,6 +1503,15 @@ void GfxTinyGL::destroyMaterial(Texture *material) {
 }
 
 void GfxTinyGL::prepareMovieFrame(Graphics::Surface* frame) {
+	// A recorded draw of the previous frame must happen before it is replaced
+	for (uint i = 0; i < _pendingBackground.size(); ++i) {
+		if (!_pendingBackground[i].data) {
+			resolveBackground();
+			break;
+		}
+	}
+	++_movieFrameId;
+
 	_smushWidth = frame->w;
 	_smushHeight = frame->h;
 
@@ -1157,10 +1521,31 @@ void GfxTinyGL::prepareMovieFrame(Graphics::Surface* frame) {
 }
 
 void GfxTinyGL::drawMovieFrame(int offsetX, int offsetY) {
+	if (_backgroundPending) {
+		BackgroundDraw draw;
+		draw.data = NULL;
+		draw.image = 0;
+		draw.x = offsetX;
+		draw.y = offsetY;
+		draw.initialDraw = false;
+		draw.renderBitmaps = false;
+		draw.renderZBitmaps = false;
+		draw.dimLevel = _dimLevel;
+		draw.movieFrame = _movieFrameId;
+		_pendingBackground.push_back(draw);
+		return;
+	}
+
+	addDamage(drawMovieFrameNow(offsetX, offsetY));
+}
+
+Common::Rect GfxTinyGL::drawMovieFrameNow(int offsetX, int offsetY) {
 	if (_smushWidth == _gameWidth && _smushHeight == _gameHeight) {
 		_zb->pbuf.copyBuffer(0, _gameWidth * _gameHeight, _smushBitmap);
+		return Common::Rect(_gameWidth, _gameHeight);
 	} else {
 		blit(_pixelFormat, NULL, (byte *)_zb->pbuf.getRawBuffer(), _smushBitmap.getRawBuffer(), offsetX, offsetY, _smushWidth, _smushHeight, false);
+		return makeRect(offsetX, offsetY, _smushWidth, _smushHeight);
 	}
 }
 
@@ -1173,6 +1558,9 @@ void GfxTinyGL::loadEmergFont() {
 void GfxTinyGL::drawEmergString(int x, int y, const char *text, const Color &fgColor) {
 	uint32 color = _pixelFormat.RGBToColor(fgColor.getRed(), fgColor.getGreen(), fgColor.getBlue());
 
+	resolveBackground();
+	addDamage(makeRect(x, y, 10 * strlen(text), 13));
+
 	for (int l = 0; l < (int)strlen(text); l++) {
 		int c = text[l];
 		assert(c >= 32 && c <= 127);
@@ -1196,6 +1584,8 @@ void GfxTinyGL::drawEmergString(int x, int y, const char *text, const Color &fgC
 }
 
 Bitmap *GfxTinyGL::getScreenshot(int w, int h) {
+	resolveBackground();
+
 	Graphics::PixelBuffer buffer = Graphics::PixelBuffer::createBuffer<565>(w * h, DisposeAfterUse::YES);
 
 	int i1 = (_gameWidth * w - 1) / _gameWidth + 1;
@@ -1225,10 +1615,13 @@ Bitmap *GfxTinyGL::getScreenshot(int w, int h) {
 }
 
 void GfxTinyGL::storeDisplay() {
+	resolveBackground();
 	_storedDisplay.copyBuffer(0, _gameWidth * _gameHeight, _zb->pbuf);
 }
 
 void GfxTinyGL::copyStoredToDisplay() {
+	resolveBackground();
+	addDamage(Common::Rect(_gameWidth, _gameHeight));
 	_zb->pbuf.copyBuffer(0, _gameWidth * _gameHeight, _storedDisplay);
 }
 
@@ -1242,6 +1635,8 @@ void GfxTinyGL::dimScreen() {
 }
 
 void GfxTinyGL::dimRegion(int x, int y, int w, int h, float level) {
+	resolveBackground();
+	addDamage(makeRect(x, y, w, h));
 	for (int ly = y; ly < y + h; ly++) {
 		for (int lx = x; lx < x + w; lx++) {
 			uint8 r, g, b;
@@ -1253,6 +1648,8 @@ void GfxTinyGL::dimRegion(int x, int y, int w, int h, float level) {
 }
 
 void GfxTinyGL::irisAroundRegion(int x1, int y1, int x2, int y2) {
+	resolveBackground();
+	addDamage(Common::Rect(_gameWidth, _gameHeight));
 	for (int ly = 0; ly < _gameHeight; ly++) {
 		for (int lx = 0; lx < _gameWidth; lx++) {
 			// Don't do anything with the data in the region we draw Around
@@ -1273,6 +1670,9 @@ void GfxTinyGL::drawRectangle(const PrimitiveObject *primitive) {
 	const Color &color = primitive->getColor();
 	uint32 c = _pixelFormat.RGBToColor(color.getRed(), color.getGreen(), color.getBlue());
 
+	resolveBackground();
+	addDamage(makeRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1));
+
 	if (primitive->isFilled()) {
 		for (; y1 <= y2; y1++)
 			if (y1 >= 0 && y1 < _gameHeight)
@@ -1307,6 +1707,10 @@ void GfxTinyGL::drawLine(const PrimitiveObject *primitive) {
 
 	const Color &color = primitive->getColor();
 
+	// The line may go up or down, as long as it goes to the right
+	resolveBackground();
+	addDamage(makeRect(x1, MIN(y1, y2), x2 - x1 + 1, ABS(y2 - y1) + 1));
+
 	if (x2 == x1) {
 		for (int y = y1; y <= y2; y++) {
 			if (x1 >= 0 && x1 < _gameWidth && y >= 0 && y < _gameHeight)
@@ -1338,6 +1742,10 @@ void GfxTinyGL::drawPolygon(const PrimitiveObject *primitive) {
 	const Color &color = primitive->getColor();
 	uint32 c = _pixelFormat.RGBToColor(color.getRed(), color.getGreen(), color.getBlue());
 
+	resolveBackground();
+	addDamage(makeRect(x1, MIN(y1, y2), x2 - x1 + 1, ABS(y2 - y1) + 1));
+	addDamage(makeRect(x3, MIN(y3, y4), x4 - x3 + 1, ABS(y4 - y3) + 1));
+
 	m = (y2 - y1) / (x2 - x1);
 	b = (int)(-m * x1 + y1);
 	for (int x = x1; x <= x2; x++) {
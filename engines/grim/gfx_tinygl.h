@@ -25,6 +25,9 @@
 
 #include "engines/grim/gfx_base.h"
 
+#include "common/array.h"
+#include "common/rect.h"
+
 #include "graphics/tinygl/zgl.h"
 
 namespace Grim {
@@ -33,6 +36,7 @@ class ModelNode;
 class Mesh;
 class MeshFace;
 class BlitImage;
+struct CachedTextLine;
 
 class GfxTinyGL : public GfxBase {
 public:
@@ -68,6 +72,7 @@ public:
 	void translateViewpointStart();
 	void translateViewpoint(const Math::Vector3d &vec);
 	void rotateViewpoint(const Math::Angle &angle, const Math::Vector3d &axis);
+	void transformViewpoint(const Math::Matrix4 &matrix);
 	void translateViewpointFinish();
 
 	void drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face);
@@ -84,6 +89,8 @@ public:
 	void destroyMaterial(Texture *material);
 
 	void createBitmap(BitmapData *bitmap);
+	void createBitmapImage(BitmapData *bitmap, int pic);
+	void destroyBitmapImage(BitmapData *bitmap, int pic);
 	void drawBitmap(const Bitmap *bitmap, int x, int y, bool initialDraw = true);
 	void destroyBitmap(BitmapData *bitmap);
 
@@ -120,15 +127,64 @@ public:
 
 	void createSpecialtyTextures();
 
+	void invalidateScreen();
+
 protected:
 
 private:
+	/**
+	 * A bitmap or movie frame drawn right after clearScreen(). These make
+	 * up the background of the scene, which is usually the same from frame
+	 * to frame, so they are recorded and only drawn again when they change.
+	 */
+	struct BackgroundDraw {
+		const BitmapData *data; // NULL for the movie frame
+		int image;
+		int x, y;
+		bool initialDraw;
+		bool renderBitmaps, renderZBitmaps;
+		float dimLevel;
+		uint32 movieFrame;
+
+		bool operator==(const BackgroundDraw &other) const;
+	};
+
 	TinyGL::ZBuffer *_zb;
 	Graphics::PixelBuffer _smushBitmap;
 	int _smushWidth;
 	int _smushHeight;
 	Graphics::PixelBuffer _storedDisplay;
 	float _alpha;
+	Common::Array<CachedTextLine *> _textCache;
+	uint32 _textCacheClock;
+
+	Common::Array<BackgroundDraw> _pendingBackground;
+	Common::Array<BackgroundDraw> _background;
+	bool _backgroundPending;
+	bool _backgroundValid;
+	Graphics::PixelBuffer _backgroundPixels;
+	unsigned int *_backgroundDepth;
+	uint32 _movieFrameId;
+	// Parts of the screen drawn over the background since it was last restored
+	Common::Array<Common::Rect> _overdrawn;
+	// Parts of the screen changed since the last flipBuffer()
+	Common::Array<Common::Rect> _damage;
+	bool _fullDamage;
+	// Part of the clean buffer actors were drawn to
+	Common::Rect _cleanBufferArea;
+
+	void resolveBackground();
+	void restoreBackground(const Common::Rect &rect);
+	void addDamage(const Common::Rect &rect);
+	void addDrawnArea();
+	Common::Rect getDrawnArea();
+	void addRect(Common::Array<Common::Rect> &rects, const Common::Rect &rect) const;
+	Common::Rect drawBitmapNow(const BitmapData *data, int image, int x, int y, bool initialDraw);
+	Common::Rect drawMovieFrameNow(int offsetX, int offsetY);
+
+	CachedTextLine *getTextLine(const Font *font, uint32 color, const Common::String &text);
+	void releaseTextLine(CachedTextLine *line);
+	void trimTextCache();
 
 	void readPixels(int x, int y, int width, int height, uint8 *buffer);
 	void blit(const Graphics::PixelFormat &format, BlitImage *blit, byte *dst, byte *src, int x, int y, int width, int height, bool trans);
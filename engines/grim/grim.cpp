@@ -39,6 +39,7 @@
 
 #include "engines/engine.h"
 
+#include "engines/grim/console.h"
 #include "engines/grim/debug.h"
 #include "engines/grim/grim.h"
 #include "engines/grim/lua.h"
@@ -50,6 +51,7 @@
 #include "engines/grim/savegame.h"
 #include "engines/grim/registry.h"
 #include "engines/grim/resource.h"
+#include "engines/grim/textcache.h"
 #include "engines/grim/localize.h"
 #include "engines/grim/gfx_base.h"
 #include "engines/grim/bitmap.h"
@@ -81,6 +83,7 @@ GrimEngine::GrimEngine(OSystem *syst, uint32 gameFlags, GrimGameType gameType, C
 
 	g_registry = new Registry();
 	g_resourceloader = NULL;
+	g_textCache = NULL;
 	g_localizer = NULL;
 	g_movie = NULL;
 	g_imuse = NULL;
@@ -112,17 +115,17 @@ GrimEngine::GrimEngine(OSystem *syst, uint32 gameFlags, GrimGameType gameType, C
 	_flipEnable = true;
 	int speed = g_registry->getInt("engine_speed");
 	if (speed <= 0 || speed > 100)
-		_speedLimitMs = 1000 / 60;
-	else
-		_speedLimitMs = 1000 / speed;
+		speed = 60;
+	_framePacer.setFrameDuration(1000000 / speed);
 	char buf[20];
-	sprintf(buf, "%d", 1000 / _speedLimitMs);
+	sprintf(buf, "%d", speed);
 	g_registry->setString("engine_speed", buf);
 	_refreshDrawNeeded = true;
 	_listFilesIter = NULL;
 	_savedState = NULL;
 	_fps[0] = 0;
 	_iris = new Iris();
+	_console = new Console(this);
 	_buildActiveActorsList = false;
 
 	Color c(0, 0, 0);
@@ -162,6 +165,7 @@ GrimEngine::~GrimEngine() {
 	delete[] _controlsEnabled;
 	delete[] _controlsState;
 
+	SaveGame::purgeCaches();
 	clearPools();
 
 	delete LuaBase::instance();
@@ -180,9 +184,12 @@ GrimEngine::~GrimEngine() {
 	g_localizer = NULL;
 	delete g_resourceloader;
 	g_resourceloader = NULL;
+	delete g_textCache;
+	g_textCache = NULL;
 	delete g_driver;
 	g_driver = NULL;
 	delete _iris;
+	delete _console;
 
 	DebugMan.clearAllDebugChannels();
 }
@@ -212,6 +219,7 @@ Common::Error GrimEngine::run() {
 	}
 
 	g_resourceloader = new ResourceLoader();
+	g_textCache = new TextCache(_targetName + "-text.cache");
 	bool demo = getGameFlags() & ADGF_DEMO;
 	if (getGameType() == GType_GRIM)
 		g_movie = CreateSmushPlayer(demo);
@@ -411,7 +419,9 @@ void GrimEngine::luaUpdate() {
 		_frameTime = 0;
 	}
 
+	_framePacer.beginPhase(FramePacer::PhaseLua);
 	LuaBase::instance()->update(_frameTime, _movieTime);
+	_framePacer.beginPhase(FramePacer::PhaseUpdate);
 
 	if (_currSet && (_mode == NormalMode || _mode == SmushMode)) {
 		// call updateTalk() before calling update(), since it may modify costumes state, and
@@ -432,6 +442,12 @@ void GrimEngine::luaUpdate() {
 			// when he needs to perform certain chores
 			a->update(_frameTime);
 		}
+		// Animating the costumes is the expensive part of the update. It is
+		// done once all the chores got updated and their marker callbacks ran,
+		// so that it doesn't depend on other actors or on the order of the list.
+		foreach (Actor *a, _activeActors) {
+			a->animate();
+		}
 
 		_iris->update(_frameTime);
 
@@ -439,6 +455,7 @@ void GrimEngine::luaUpdate() {
 			t->update();
 		}
 	}
+	_framePacer.endPhase();
 }
 
 void GrimEngine::updateDisplayScene() {
@@ -564,6 +581,7 @@ void GrimEngine::updateDisplayScene() {
 
 void GrimEngine::doFlip() {
 	_frameCounter++;
+	BitmapData::startFrame();
 	if (!_doFlip) {
 		return;
 	}
@@ -599,8 +617,10 @@ void GrimEngine::mainLoop() {
 	_changeFullscreenState = false;
 	_setupChanged = true;
 
+	_framePacer.resync();
+
 	for (;;) {
-		uint32 startTime = g_system->getMillis();
+		_framePacer.beginFrame();
 		if (_shortFrame) {
 			if (resetShortFrame) {
 				_shortFrame = false;
@@ -613,10 +633,13 @@ void GrimEngine::mainLoop() {
 
 		if (_savegameLoadRequest) {
 			savegameRestore();
+			_framePacer.resync();
 		}
 		if (_savegameSaveRequest) {
 			savegameSave();
+			_framePacer.resync();
 		}
+		SaveGame::pollPendingWrites();
 
 		if (_changeHardwareState || _changeFullscreenState) {
 			_changeHardwareState = false;
@@ -632,9 +655,13 @@ void GrimEngine::mainLoop() {
 
 			EngineMode mode = getMode();
 
-			_savegameFileName = "";
-			savegameSave();
-			clearPools();
+			byte shadowR, shadowG, shadowB;
+			g_driver->getShadowColor(&shadowR, &shadowG, &shadowB);
+			bool renderBitmaps = g_driver->getRenderBitmaps();
+			bool renderZBitmaps = g_driver->getRenderZBitmaps();
+			SpecialtyMaterial specialty[GfxBase::kNumSpecialtyTextures];
+			g_driver->releaseSpecialtyTextures(specialty);
+			releaseRenderResources();
 
 			delete g_driver;
 			if (g_registry->getBool("soft_renderer")) {
@@ -644,7 +671,11 @@ void GrimEngine::mainLoop() {
 			}
 
 			g_driver->setupScreen(screenWidth, screenHeight, fullscreen);
-			savegameRestore();
+			g_driver->setShadowColor(shadowR, shadowG, shadowB);
+			g_driver->renderBitmaps(renderBitmaps);
+			g_driver->renderZBitmaps(renderZBitmaps);
+			g_driver->restoreSpecialtyTextures(specialty);
+			createRenderResources();
 
 			if (mode == DrawMode) {
 				setMode(GrimEngine::NormalMode);
@@ -654,6 +685,7 @@ void GrimEngine::mainLoop() {
 			}
 			setMode(mode);
 			_changeFullscreenState = false;
+			_framePacer.resync();
 		}
 
 		g_imuse->flushTracks();
@@ -666,7 +698,13 @@ void GrimEngine::mainLoop() {
 			Common::EventType type = event.type;
 			if (type == Common::EVENT_KEYDOWN || type == Common::EVENT_KEYUP) {
 				if (type == Common::EVENT_KEYDOWN) {
-					if (_mode != DrawMode && _mode != SmushMode && (event.kbd.ascii == 'q')) {
+					if (event.kbd.keycode == Common::KEYCODE_d && (event.kbd.flags & Common::KBD_CTRL)) {
+						_console->attach();
+						_console->onFrame();
+						g_driver->invalidateScreen();
+						_framePacer.resync();
+						continue;
+					} else if (_mode != DrawMode && _mode != SmushMode && (event.kbd.ascii == 'q')) {
 						handleExit();
 						break;
 					} else if (_mode != DrawMode && (event.kbd.keycode == Common::KEYCODE_PAUSE)) {
@@ -693,8 +731,11 @@ void GrimEngine::mainLoop() {
 		luaUpdate();
 
 		if (_mode != PauseMode) {
+			_framePacer.beginPhase(FramePacer::PhaseDraw);
 			updateDisplayScene();
+			_framePacer.beginPhase(FramePacer::PhaseFlip);
 			doFlip();
+			_framePacer.endPhase();
 		}
 
 		if (g_imuseState != -1) {
@@ -702,17 +743,54 @@ void GrimEngine::mainLoop() {
 			g_imuseState = -1;
 		}
 
-		uint32 endTime = g_system->getMillis();
-		if (startTime > endTime)
-			continue;
-		uint32 diffTime = endTime - startTime;
-		if (_speedLimitMs == 0)
-			continue;
-		if (diffTime < _speedLimitMs) {
-			uint32 delayTime = _speedLimitMs - diffTime;
-			g_system->delayMillis(delayTime);
+		_framePacer.endFrame();
+	}
+}
+
+void GrimEngine::releaseRenderResources() {
+	foreach (TextObject *t, TextObject::getPool()) {
+		t->destroy();
+	}
+
+	foreach (Font *f, Font::getPool()) {
+		g_driver->destroyFont(f);
+		f->setUserData(NULL);
+	}
+
+	foreach (Bitmap *b, Bitmap::getPool()) {
+		b->_data->releaseRenderResources();
+	}
+
+	if (MaterialData::_materials) {
+		foreach (MaterialData *m, *MaterialData::_materials) {
+			m->releaseTextures();
 		}
 	}
+
+	g_driver->releaseMovieFrame();
+}
+
+void GrimEngine::createRenderResources() {
+	foreach (Font *f, Font::getPool()) {
+		g_driver->createFont(f);
+	}
+
+	foreach (Bitmap *b, Bitmap::getPool()) {
+		b->_data->restoreRenderResources();
+	}
+
+	// The EMI models point at the specialty textures of the old renderer
+	g_resourceloader->rebindSpecialtyTextures();
+
+	// Text objects and materials are created again when they are drawn.
+	// The movie frame must be prepared again for the new renderer, too.
+	if (g_movie->isPlaying() && g_movie->getFrame() >= 0) {
+		g_driver->prepareMovieFrame(g_movie->getDstSurface());
+		_prevSmushFrame = -1;
+	}
+
+	_refreshShadowMask = true;
+	_setupChanged = true;
 }
 
 void GrimEngine::changeHardwareState() {
@@ -882,10 +960,11 @@ void GrimEngine::savegameSave() {
 	if (getGameType() == GType_MONKEY4 && filename.contains('/')) {
 		filename = Common::lastPathComponent(filename, '/');
 	}
-	_savedState = SaveGame::openForSaving(filename);
+	_savedState = SaveGame::openForSaving(filename, true);
 	if (!_savedState) {
 		//TODO: Translate this!
 		GUI::displayErrorDialog("Error: the game could not be saved.");
+		g_driver->invalidateScreen();
 		return;
 	}
 
@@ -1151,6 +1230,10 @@ void GrimEngine::clearEventQueue() {
 	}
 }
 
+GUI::Debugger *GrimEngine::getDebugger() {
+	return _console;
+}
+
 bool GrimEngine::hasFeature(EngineFeature f) const {
 	return
 		(f == kSupportsRTL) ||
@@ -33,10 +33,12 @@
 
 #include "engines/grim/textobject.h"
 #include "engines/grim/iris.h"
+#include "engines/grim/framepacer.h"
 
 namespace Grim {
 
 class Actor;
+class Console;
 class SaveGame;
 class Bitmap;
 class Font;
@@ -116,6 +118,7 @@ public:
 	void playIrisAnimation(Iris::Direction dir, int x, int y, int time);
 
 	void mainLoop();
+	FramePacer &getFramePacer() { return _framePacer; }
 	unsigned getFrameStart() const { return _frameStart; }
 	unsigned getFrameTime() const { return _frameTime; }
 
@@ -173,6 +176,7 @@ public:
 
 	// Engine APIs
 	bool hasFeature(EngineFeature f) const;
+	GUI::Debugger *getDebugger();
 
 	Common::StringArray _listFiles;
 	Common::StringArray::const_iterator _listFilesIter;
@@ -192,6 +196,20 @@ private:
 	void buildActiveActorsList();
 	void savegameCallback();
 
+	/**
+	 * Release the resources the renderer holds for bitmaps, fonts, text objects
+	 * and materials, so that g_driver can be replaced while keeping the
+	 * game state in memory.
+	 *
+	 * @see createRenderResources
+	 */
+	void releaseRenderResources();
+	/**
+	 * Recreate with the current renderer the resources released by
+	 * releaseRenderResources().
+	 */
+	void createRenderResources();
+
 	void savegameSave();
 	void saveGRIM();
 
@@ -221,7 +239,7 @@ private:
 	int _prevSmushFrame;
 	unsigned int _frameCounter;
 	unsigned int _lastFrameTime;
-	unsigned _speedLimitMs;
+	FramePacer _framePacer;
 	bool _showFps;
 	bool _softRenderer;
 
@@ -233,6 +251,7 @@ private:
 
 	Actor *_selectedActor;
 	Iris *_iris;
+	Console *_console;
 	TextObject::Ptr _movieSubtitle;
 
 	bool _buildActiveActorsList;
@@ -36,7 +36,6 @@ namespace Grim {
 
 Imuse *g_imuse = NULL;
 
-extern uint16 imuseDestTable[];
 extern ImuseTable grimStateMusicTable[];
 extern ImuseTable grimSeqMusicTable[];
 extern ImuseTable grimDemoStateMusicTable[];
@@ -60,7 +59,7 @@ Imuse::Imuse(int fps, bool demo) {
 		memset(_track[l], 0, sizeof(Track));
 		_track[l]->trackId = l;
 	}
-	vimaInit(imuseDestTable);
+	vimaInit();
 	if (_demo) {
 		_stateMusicTable = grimDemoStateMusicTable;
 		_seqMusicTable = grimDemoSeqMusicTable;
@@ -258,7 +258,7 @@ void LuaBase::update(int frameTime, int movieTime) {
 	_frameTimeCollection += frameTime;
 	if (_frameTimeCollection > 10000) {
 		_frameTimeCollection = 0;
-		lua_collectgarbage(0);
+		lua_stepgarbage();
 	}
 
 	lua_beginblock();
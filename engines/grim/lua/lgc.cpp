@@ -6,6 +6,8 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_setjmp
 #define FORBIDDEN_SYMBOL_EXCEPTION_longjmp
 
+#include "common/system.h"
+
 #include "engines/grim/lua/ldo.h"
 #include "engines/grim/lua/lfunc.h"
 #include "engines/grim/lua/lgc.h"
@@ -129,20 +131,54 @@ void luaC_strcallIM(TaggedString *l) {
 	}
 }
 
-static GCnode *listcollect(GCnode *l) {
-	GCnode *frees = NULL;
-	while (l) {
-		GCnode *next = l->next;
-		l->marked = 0;
-		while (next && !next->marked) {
-			l->next = next->next;
-			next->next = frees;
-			frees = next;
-			next = l->next;
-		}
-		l = next;
-	}
-	return frees;
+/*
+** =======================================================
+** Incremental collector
+** =======================================================
+**
+** A cycle marks the objects reachable from the roots in bounded steps,
+** keeping the objects still to be traversed in a gray stack. Tables are
+** the only objects that change after creation, so a store into a table
+** that was already traversed puts it back in the gray stack. The roots
+** themselves (every task stack, the globals, the locked refs and the tag
+** methods) are not guarded, so they are marked again atomically before
+** the sweep. The sweep then frees the dead strings and objects in bounded
+** steps as well; objects created meanwhile are never swept by the cycle.
+*/
+
+#define GCSTEPSIZE		1024  // units of work done by each step
+#define GCSTEPBLOCKS	64    // blocks allocated between two steps of a cycle
+#define GRAYMARK		3     // marked, but its references are not traversed
+
+enum GCPhase {
+	GCpause,			// no cycle in progress
+	GCpropagate,		// traversing the gray objects
+	GCsweepstring,		// sweeping the string tables
+	GCsweep,			// sweeping the tables, prototypes and closures
+	GCfinalize			// calling the gc tag methods of the dead objects
+};
+
+static GCPhase GCphase = GCpause;
+static int32 GCwork;
+static TObject *graystack = NULL;
+static int32 graysize = 0;
+static int32 graytop = 0;
+static int32 sweepstr;
+static GCnode *sweeproots[] = { &roottable, &rootproto, &rootcl };
+static int32 sweeplist;
+static GCnode *sweepnode;
+static int32 sweepdefer;  // gc tag methods may still look at the dead objects
+static GCnode *sweepfrees[3];
+static TaggedString *freestr;
+static lua_GCStats GCstats;
+
+static void graypush(lua_Type t, GCnode *node) {
+	if (graytop >= graysize)
+		graysize = luaM_growvector(&graystack, graysize, TObject, memEM, MAX_INT);
+	node->marked = GRAYMARK;
+	graystack[graytop].ttype = t;
+	graystack[graytop].value.ts = (TaggedString *)node;
+	graytop++;
 }
 
 static void strmark(TaggedString *s) {
@@ -151,44 +187,41 @@ static void strmark(TaggedString *s) {
 }
 
 static void protomark(TProtoFunc *f) {
-	if (!f->head.marked) {
-		LocVar *v = f->locvars;
-		int32 i;
-		f->head.marked = 1;
-		if (f->fileName)
-			strmark(f->fileName);
-		for (i = 0; i < f->nconsts; i++)
-			markobject(&f->consts[i]);
-		if (v) {
-			for (; v->line != -1; v++) {
-				if (v->varname)
-					strmark(v->varname);
-			}
+	LocVar *v = f->locvars;
+	int32 i;
+	f->head.marked = 1;
+	if (f->fileName)
+		strmark(f->fileName);
+	for (i = 0; i < f->nconsts; i++)
+		markobject(&f->consts[i]);
+	if (v) {
+		for (; v->line != -1; v++) {
+			if (v->varname)
+				strmark(v->varname);
 		}
 	}
+	GCwork += f->nconsts + 1;
 }
 
 static void closuremark(Closure *f) {
-	if (!f->head.marked) {
-		int32 i;
-		f->head.marked = 1;
-		for (i = f->nelems; i >= 0; i--)
-			markobject(&f->consts[i]);
-	}
+	int32 i;
+	f->head.marked = 1;
+	for (i = f->nelems; i >= 0; i--)
+		markobject(&f->consts[i]);
+	GCwork += f->nelems + 1;
 }
 
 static void hashmark(Hash *h) {
-	if (!h->head.marked) {
-		int32 i;
-		h->head.marked = 1;
-		for (i = 0; i < nhash(h); i++) {
-			Node *n = node(h, i);
-			if (ttype(ref(n)) != LUA_T_NIL) {
-				markobject(&n->ref);
-				markobject(&n->val);
-			}
+	int32 i;
+	h->head.marked = 1;
+	for (i = 0; i < nhash(h); i++) {
+		Node *n = node(h, i);
+		if (ttype(ref(n)) != LUA_T_NIL) {
+			markobject(&n->ref);
+			markobject(&n->val);
 		}
 	}
+	GCwork += nhash(h) + 1;
 }
 
 static void globalmark() {
@@ -201,21 +234,31 @@ static void globalmark() {
 	}
 }
 
+static void taskmark() {
+	LState *state;
+	// task stacks are traversed by luaD_travstack, but not their functions
+	for (state = lua_rootState; state != NULL; state = state->next)
+		markobject(&state->taskFunc);
+}
+
 static int32 markobject(TObject *o) {
 	switch (ttype(o)) {
 	case LUA_T_STRING:
 		strmark(tsvalue(o));
 		break;
 	case LUA_T_ARRAY:
-		hashmark(avalue(o));
+		if (!avalue(o)->head.marked)
+			graypush(LUA_T_ARRAY, (GCnode *)avalue(o));
 		break;
 	case LUA_T_CLOSURE:
 	case LUA_T_CLMARK:
-		closuremark(o->value.cl);
+		if (!o->value.cl->head.marked)
+			graypush(LUA_T_CLOSURE, (GCnode *)o->value.cl);
 		break;
 	case LUA_T_PROTO:
 	case LUA_T_PMARK:
-		protomark(o->value.tf);
+		if (!o->value.tf->head.marked)
+			graypush(LUA_T_PROTO, (GCnode *)o->value.tf);
 		break;
 	default:
 		break;  // numbers, cprotos, etc
@@ -223,41 +266,254 @@ static int32 markobject(TObject *o) {
 	return 0;
 }
 
-static void markall() {
+static void markroots() {
 	luaD_travstack(markobject); // mark stack objects
 	globalmark();  // mark global variable values and names
 	travlock(); // mark locked objects
 	luaT_travtagmethods(markobject);  // mark fallbacks
+	taskmark();  // mark task functions
 }
 
-int32 lua_collectgarbage(int32 limit) {
-	int32 recovered = nblocks;  // to subtract nblocks after gc
-	Hash *freetable;
-	TaggedString *freestr;
-	TProtoFunc *freefunc;
-	Closure *freeclos;
-	markall();
+static void propagate() {
+	TObject *o = &graystack[--graytop];
+	switch (ttype(o)) {
+	case LUA_T_ARRAY:
+		hashmark(avalue(o));
+		break;
+	case LUA_T_CLOSURE:
+		closuremark(o->value.cl);
+		break;
+	default:
+		protomark(o->value.tf);
+		break;
+	}
+}
+
+void luaC_barrierback(Hash *t) {
+	if (GCphase == GCpropagate)
+		graypush(LUA_T_ARRAY, (GCnode *)t);
+}
+
+void luaC_keepstring(TaggedString *ts, int32 table) {
+	// the string is live again, but its table may not have been swept yet
+	if (GCphase == GCsweepstring && table >= sweepstr)
+		ts->head.marked = 1;
+}
+
+static int32 hasgcIM() {
+	int32 t;
+	for (t = 0; t >= last_tag; t--) {
+		if (ttype(luaT_getim(t, IM_GC)) != LUA_T_NIL)
+			return 1;
+	}
+	return 0;
+}
+
+void luaC_keepobject(GCnode *root, GCnode *node) {
+	// created after the marks were final, but ahead of the sweep of its list
+	int32 i = (root == &roottable) ? 0 : (root == &rootproto) ? 1 : 2;
+	if (GCphase == GCsweepstring || (GCphase == GCsweep && (i > sweeplist || (i == sweeplist && sweepnode == root))))
+		node->marked = 1;
+}
+
+static void atomic() {
+	markroots();
+	while (graytop > 0)
+		propagate();
+	luaM_free(graystack);
+	graystack = NULL;
+	graysize = 0;
 	invalidaterefs();
-	freestr = luaS_collector();
-	freetable = (Hash *)listcollect(&roottable);
-	freefunc = (TProtoFunc *)listcollect(&rootproto);
-	freeclos = (Closure *)listcollect(&rootcl);
-	GCthreshold *= 4;  // to avoid GC during GC
+	luaS_collectglobals();
+	sweepdefer = hasgcIM();
+	GCphase = GCsweepstring;
+	sweepstr = 0;
+}
+
+/*
+** Frees the dead strings of the string table 'i', or keeps them for the
+** end of the cycle if there are gc tag methods.
+*/
+static void sweepstrings(int32 i) {
+	TaggedString *frees = NULL;
+	GCwork += luaS_sweep(i, &frees);
+	while (frees) {
+		TaggedString *next = (TaggedString *)frees->head.next;
+		if (sweepdefer) {
+			frees->head.next = (GCnode *)freestr;
+			freestr = frees;
+		} else {
+			frees->head.next = NULL;
+			luaS_free(frees);
+		}
+		frees = next;
+		GCwork++;
+	}
+}
+
+static void freeobject(GCnode *o) {
+	if (sweepdefer) {
+		o->next = sweepfrees[sweeplist];
+		sweepfrees[sweeplist] = o;
+		return;
+	}
+	o->next = NULL;
+	switch (sweeplist) {
+	case 0:
+		luaH_free((Hash *)o);
+		break;
+	case 1:
+		luaF_freeproto((TProtoFunc *)o);
+		break;
+	default:
+		luaF_freeclosure((Closure *)o);
+		break;
+	}
+}
+
+/*
+** Sweeps the current list until 'GCwork' reaches 'limit'. Objects
+** created while the sweep is at the list head are kept alive by
+** luaC_keepobject; the later ones are inserted behind 'sweepnode'.
+*/
+static int32 sweepstep(int32 limit) {
+	GCnode *l = sweepnode;
+	do {
+		GCnode *next = l->next;
+		if (next && !next->marked) {
+			l->next = next->next;
+			freeobject(next);
+		} else {
+			l->marked = 0;
+			l = next;
+		}
+		GCwork++;
+	} while (l && (limit <= 0 || GCwork < limit));
+	sweepnode = l;
+	return l == NULL;
+}
+
+static void finishcycle() {
+	Hash *freetable = (Hash *)sweepfrees[0];
+	TProtoFunc *freefunc = (TProtoFunc *)sweepfrees[1];
+	Closure *freeclos = (Closure *)sweepfrees[2];
+	TaggedString *frees = freestr;
+	sweepfrees[0] = sweepfrees[1] = sweepfrees[2] = NULL;
+	freestr = NULL;
+	GCphase = GCfinalize;  // to avoid GC during GC
 	luaC_hashcallIM(freetable);  // GC tag methods for tables
-	luaC_strcallIM(freestr);  // GC tag methods for userdata
+	luaC_strcallIM(frees);  // GC tag methods for userdata
 	luaD_gcIM(&luaO_nilobject);  // GC tag method for nil (signal end of GC)
 	luaH_free(freetable);
-	luaS_free(freestr);
+	luaS_free(frees);
 	luaF_freeproto(freefunc);
 	luaF_freeclosure(freeclos);
+	GCphase = GCpause;
+	GCthreshold = 2 * nblocks;
+	GCstats.cycles++;
+}
+
+/*
+** Runs the current cycle until 'limit' units of work are done, or to its
+** end if 'limit' is 0.
+*/
+static void gcstep(int32 limit) {
+	GCwork = 0;
+	while (GCphase != GCpause && (limit <= 0 || GCwork < limit)) {
+		switch (GCphase) {
+		case GCpropagate:
+			if (graytop > 0)
+				propagate();
+			else
+				atomic();
+			break;
+		case GCsweepstring:
+			if (sweepstr < NUM_HASHS)
+				sweepstrings(sweepstr++);
+			else {
+				GCphase = GCsweep;
+				sweeplist = 0;
+				sweepnode = sweeproots[0];
+			}
+			break;
+		case GCsweep:
+			if (sweepstep(limit)) {
+				if (++sweeplist < 3)
+					sweepnode = sweeproots[sweeplist];
+				else
+					finishcycle();
+			}
+			break;
+		default:
+			return;
+		}
+	}
+}
+
+static void recordpause(uint32 start) {
+	uint32 pause = g_system->getMicros() - start;
+	GCstats.lastPause = pause;
+	GCstats.totalPause += pause;
+	if (pause > GCstats.maxPause)
+		GCstats.maxPause = pause;
+}
+
+void luaC_step() {
+	uint32 start;
+	if (GCphase == GCfinalize)
+		return;
+	start = g_system->getMicros();
+	if (GCphase == GCpause) {
+		GCphase = GCpropagate;
+		markroots();
+	}
+	gcstep(GCSTEPSIZE);
+	if (GCphase != GCpause)
+		GCthreshold = nblocks + GCSTEPBLOCKS;
+	GCstats.steps++;
+	recordpause(start);
+}
+
+void luaC_tick() {
+	if (GCphase != GCpause)
+		luaC_step();
+}
+
+void luaC_finishcycle() {
+	if (GCphase != GCpause && GCphase != GCfinalize)
+		gcstep(0);
+}
+
+int32 lua_collectgarbage(int32 limit) {
+	int32 recovered = nblocks;  // to subtract nblocks after gc
+	uint32 start;
+	if (GCphase == GCfinalize)
+		return 0;
+	start = g_system->getMicros();
+	luaC_finishcycle();  // its marks may be older than the current state
+	GCphase = GCpropagate;
+	markroots();
+	gcstep(0);
 	recovered = recovered - nblocks;
 	GCthreshold = (limit == 0) ? 2 * nblocks : nblocks + limit;
+	GCstats.fullCollections++;
+	recordpause(start);
 	return recovered;
 }
 
+void lua_stepgarbage() {
+	luaC_step();
+}
+
+const lua_GCStats *lua_getgcstats() {
+	GCstats.blocks = nblocks;
+	GCstats.threshold = GCthreshold;
+	return &GCstats;
+}
+
 void luaC_checkGC() {
 	if (nblocks >= GCthreshold)
-		lua_collectgarbage(0);
+		luaC_step();
 }
 
 } // end of namespace Grim
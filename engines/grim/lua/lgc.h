@@ -12,11 +12,22 @@
 namespace Grim {
 
 void luaC_checkGC();
+void luaC_step();
+void luaC_tick();
+void luaC_finishcycle();
+void luaC_barrierback(Hash *t);
+void luaC_keepstring(TaggedString *ts, int32 table);
+void luaC_keepobject(GCnode *root, GCnode *node);
 TObject* luaC_getref(int32 r);
 int32 luaC_ref(TObject *o, int32 lock);
 void luaC_hashcallIM(Hash *l);
 void luaC_strcallIM(TaggedString *l);
 
+// a traversed table being changed must be traversed again
+#define luaC_tablebarrier(t)		{ if ((t)->head.marked == 1) luaC_barrierback(t); }
+// a string found again in its table must survive the sweep in progress
+#define luaC_stringbarrier(ts, i)	{ if (!(ts)->head.marked) luaC_keepstring(ts, i); }
+
 } // end of namespace Grim
 
 #endif
@@ -6,6 +6,9 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_setjmp
 #define FORBIDDEN_SYMBOL_EXCEPTION_longjmp
 
+#include "common/memorypool.h"
+#include "common/util.h"
+
 #include "engines/grim/lua/lmem.h"
 #include "engines/grim/lua/lstate.h"
 #include "engines/grim/lua/lua.h"
@@ -22,25 +25,127 @@ int32 luaM_growaux(void **block, int32 nelems, int32 size, const char *errormsg,
 	return (int32)nelems;
 }
 
+void *luaM_alloc(int32 size) {
+	return luaM_realloc(NULL, size ? size : 1);
+}
+
 #ifndef LUA_DEBUG
 
 /*
-** generic allocation routine.
-** real ANSI systems do not need some of these tests,
-** since realloc(NULL, s)==malloc(s) and realloc(b, 0)==free(b).
-** But some systems (e.g. Sun OS) are not that ANSI...
+** Small blocks come from a Common::MemoryPool per size class, larger ones
+** from the system allocator. Every block is preceded by a header with its
+** size and class, so it can be resized or freed without knowing where it
+** came from.
 */
+
+#define MAXSMALL	256
+#define LARGECLASS	(NUM_SIZECLASSES - 1)
+
+struct BlockHeader {
+	int32 size;
+	int32 sizeClass;
+};
+
+static const int32 classSize[NUM_SIZECLASSES] = {
+	8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, MAX_INT
+};
+
+// size class of the blocks up to MAXSMALL bytes, indexed by (size + 7) / 8
+static const byte sizeClassTable[MAXSMALL / 8 + 1] = {
+	0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+	12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+};
+
+static Common::MemoryPool *pools[LARGECLASS];
+static int32 classBlocks[NUM_SIZECLASSES];
+static int32 classBytes[NUM_SIZECLASSES];
+
+static int32 sizeclass(int32 size) {
+	return (size <= MAXSMALL) ? sizeClassTable[(size + 7) / 8] : LARGECLASS;
+}
+
+static void *allocblock(int32 size) {
+	int32 c = sizeclass(size);
+	BlockHeader *h;
+	if (c == LARGECLASS) {
+		h = (BlockHeader *)malloc(sizeof(BlockHeader) + size);
+		if (!h)
+			lua_error(memEM);
+	} else {
+		if (!pools[c])
+			pools[c] = new Common::MemoryPool(sizeof(BlockHeader) + classSize[c]);
+		h = (BlockHeader *)pools[c]->allocChunk();
+	}
+	h->size = size;
+	h->sizeClass = c;
+	classBlocks[c]++;
+	classBytes[c] += size;
+	return h + 1;
+}
+
+static void freeblock(BlockHeader *h) {
+	classBlocks[h->sizeClass]--;
+	classBytes[h->sizeClass] -= h->size;
+	if (h->sizeClass == LARGECLASS)
+		free(h);
+	else
+		pools[h->sizeClass]->freeChunk(h);
+}
+
 void *luaM_realloc(void *block, int32 size) {
+	BlockHeader *h;
+	int32 c;
 	if (size == 0) {
-		free(block);
+		if (block)
+			freeblock((BlockHeader *)block - 1);
 		return NULL;
 	}
-	block = block ? realloc(block, size) : malloc(size);
 	if (!block)
-		lua_error(memEM);
+		return allocblock(size);
+	h = (BlockHeader *)block - 1;
+	c = sizeclass(size);
+	if (c == h->sizeClass && c != LARGECLASS) {  // still fits in its chunk
+		classBytes[c] += size - h->size;
+		h->size = size;
+		return block;
+	}
+	if (c == LARGECLASS && h->sizeClass == LARGECLASS) {
+		h = (BlockHeader *)realloc(h, sizeof(BlockHeader) + size);
+		if (!h)
+			lua_error(memEM);
+		classBytes[c] += size - h->size;
+		h->size = size;
+		return h + 1;
+	}
+	block = allocblock(size);
+	memcpy(block, h + 1, MIN(size, h->size));
+	freeblock(h);
 	return block;
 }
 
+void luaM_getstats(int32 sizeClass, int32 *maxSize, int32 *blocks, int32 *bytes) {
+	*maxSize = classSize[sizeClass];
+	*blocks = classBlocks[sizeClass];
+	*bytes = classBytes[sizeClass];
+}
+
+/*
+** Releases the pools once the state is closed. Blocks that outlive the
+** state (like the list of libraries) keep their pool alive.
+*/
+void luaM_closepools() {
+	int32 c;
+	for (c = 0; c < LARGECLASS; c++) {
+		if (!pools[c])
+			continue;
+		if (classBlocks[c] == 0) {
+			delete pools[c];
+			pools[c] = NULL;
+		} else
+			pools[c]->freeUnusedPages();
+	}
+}
+
 #else
 /* LUA_DEBUG */
 
@@ -85,6 +190,15 @@ void *luaM_realloc(void *block, int32 size) {
 	return (int32 *)block+1;
 }
 
+void luaM_getstats(int32 sizeClass, int32 *maxSize, int32 *blocks, int32 *bytes) {
+	*maxSize = 0;
+	*blocks = 0;
+	*bytes = 0;
+}
+
+void luaM_closepools() {
+}
+
 #endif
 
 } // end of namespace Grim
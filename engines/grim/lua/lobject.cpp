@@ -6,6 +6,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_setjmp
 #define FORBIDDEN_SYMBOL_EXCEPTION_longjmp
 
+#include "engines/grim/lua/lgc.h"
 #include "engines/grim/lua/lobject.h"
 #include "engines/grim/lua/lua.h"
 #include "engines/grim/lua/lstring.h"
@@ -81,6 +82,7 @@ void luaO_insertlist(GCnode *root, GCnode *node) {
 	node->next = root->next;
 	root->next = node;
 	node->marked = 0;
+	luaC_keepobject(root, node);
 }
 
 } // end of namespace Grim
@@ -113,7 +113,7 @@ void lua_statedeinit(LState *state) {
 		}
 	}
 
-	free(state->stack.stack);
+	luaM_free(state->stack.stack);
 }
 
 void lua_resetglobals() {
@@ -210,6 +210,7 @@ void lua_open() {
 }
 
 void lua_close() {
+	luaC_finishcycle();
 	TaggedString *alludata = luaS_collectudata();
 	GCthreshold = MAX_INT;  // to avoid GC during GC
 	luaC_hashcallIM((Hash *)roottable.next);  // GC t.methods for tables
@@ -236,6 +237,7 @@ void lua_close() {
 	IMtable = NULL;
 	refArray = NULL;
 	lua_rootState = lua_state = NULL;
+	luaM_closepools();
 
 #ifdef LUA_DEBUG
 	printf("total de blocos: %ld\n", numblocks);
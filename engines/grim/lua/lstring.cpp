@@ -8,6 +8,7 @@
 
 #include "common/util.h"
 
+#include "engines/grim/lua/lgc.h"
 #include "engines/grim/lua/lmem.h"
 #include "engines/grim/lua/lobject.h"
 #include "engines/grim/lua/lstate.h"
@@ -106,8 +107,10 @@ static TaggedString *insert(const char *buff, int32 tag, stringtable *tb) {
 			j = i;
 		else if ((ts->constindex >= 0) ? // is a string?
 				(tag == LUA_T_STRING && (strcmp(buff, ts->str) == 0)) :
-				((tag == ts->globalval.ttype || tag == LUA_ANYTAG) && buff == (const char *)ts->globalval.value.ts))
+				((tag == ts->globalval.ttype || tag == LUA_ANYTAG) && buff == (const char *)ts->globalval.value.ts)) {
+			luaC_stringbarrier(ts, tb - string_root);
 			return ts;
+		}
 		if (++i == size)
 			i = 0;
 	}
@@ -117,6 +120,7 @@ static TaggedString *insert(const char *buff, int32 tag, stringtable *tb) {
 	else
 		tb->nuse++;
 	ts = tb->hash[i] = newone(buff, tag, h);
+	luaC_stringbarrier(ts, tb - string_root);
 	return ts;
 }
 
@@ -138,7 +142,7 @@ TaggedString *luaS_new(const char *str) {
 
 TaggedString *luaS_newfixedstring(const char *str) {
 	TaggedString *ts = luaS_new(str);
-	if (ts->head.marked == 0)
+	if (ts->head.marked < 2)
 		ts->head.marked = 2;  // avoid GC
 	return ts;
 }
@@ -156,36 +160,43 @@ void luaS_free(TaggedString *l) {
 ** Garbage collection functions.
 */
 
-static void remove_from_list(GCnode *l) {
+/*
+** Unlinks the dead strings from the list of globals, so a string found
+** again before it is swept is linked back when its value is set.
+*/
+void luaS_collectglobals() {
+	GCnode *l = &rootglobal;
 	while (l) {
 		GCnode *next = l->next;
-		while (next && !next->marked)
-			next = l->next = next->next;
+		while (next && !next->marked) {
+			l->next = next->next;
+			next->next = next;  // signal it is in no list
+			next = l->next;
+		}
 		l = next;
 	}
 }
 
-TaggedString *luaS_collector() {
-	TaggedString *frees = NULL;
-	int32 i;
-	remove_from_list(&rootglobal);
-	for (i = 0; i < NUM_HASHS; i++) {
-		stringtable *tb = &string_root[i];
-		int32 j;
-		for (j = 0; j < tb->size; j++) {
-			TaggedString *t = tb->hash[j];
-			if (!t)
-				continue;
-			if (t->head.marked == 1)
-				t->head.marked = 0;
-			else if (!t->head.marked) {
-				t->head.next = (GCnode *)frees;
-				frees = t;
-				tb->hash[j] = &EMPTY;
-			}
+/*
+** Sweeps string table 'i', chaining its dead strings in 'frees'.
+** Returns the number of slots visited.
+*/
+int32 luaS_sweep(int32 i, TaggedString **frees) {
+	stringtable *tb = &string_root[i];
+	int32 j;
+	for (j = 0; j < tb->size; j++) {
+		TaggedString *t = tb->hash[j];
+		if (!t)
+			continue;
+		if (t->head.marked == 1)
+			t->head.marked = 0;
+		else if (!t->head.marked) {
+			t->head.next = (GCnode *)*frees;
+			*frees = t;
+			tb->hash[j] = &EMPTY;
 		}
 	}
-	return frees;
+	return tb->size;
 }
 
 TaggedString *luaS_collectudata() {
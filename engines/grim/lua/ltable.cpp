@@ -7,6 +7,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_longjmp
 
 #include "engines/grim/lua/lauxlib.h"
+#include "engines/grim/lua/lgc.h"
 #include "engines/grim/lua/lmem.h"
 #include "engines/grim/lua/lobject.h"
 #include "engines/grim/lua/lstate.h"
@@ -220,6 +221,7 @@ TObject *luaH_get(Hash *t, TObject *r) {
 */
 TObject *luaH_set(Hash *t, TObject *r) {
 	Node *n = node(t, present(t, r));
+	luaC_tablebarrier(t);
 	if (ttype(ref(n)) == LUA_T_NIL) {
 		nuse(t)++;
 		if ((float)nuse(t) > (float)nhash(t) * REHASH_LIMIT) {
@@ -10,6 +10,7 @@
 #include "engines/grim/lua/lauxlib.h"
 #include "engines/grim/lua/lmem.h"
 #include "engines/grim/lua/ldo.h"
+#include "engines/grim/lua/lgc.h"
 #include "engines/grim/lua/lvm.h"
 #include "engines/grim/grim.h"
 
@@ -251,7 +252,14 @@ void sleep_for() {
 }
 
 void lua_runtasks() {
-	if (!lua_state || !lua_state->next) {
+	if (!lua_state) {
+		return;
+	}
+
+	// Advance the garbage collection cycle in progress
+	luaC_tick();
+
+	if (!lua_state->next) {
 		return;
 	}
 
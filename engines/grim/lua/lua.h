@@ -130,6 +130,20 @@ void lua_unref(int32 ref);
 
 lua_Object lua_createtable();
 int32 lua_collectgarbage(int32 limit);
+void lua_stepgarbage();
+
+struct lua_GCStats {
+	uint32 cycles;  // incremental cycles completed
+	uint32 fullCollections;
+	uint32 steps;
+	uint32 lastPause;  // in microseconds
+	uint32 maxPause;
+	uint32 totalPause;
+	int32 blocks;  // current GC weight of the live objects
+	int32 threshold;
+};
+
+const lua_GCStats *lua_getgcstats();
 
 void lua_runtasks();
 void current_script();
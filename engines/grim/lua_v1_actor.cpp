@@ -646,20 +646,17 @@ void Lua_V1::GetActorNodeLocation() {
 	ModelNode *allNodes = actor->getCurrentCostume()->getModelNodes();
 	ModelNode *node = allNodes + nodeId;
 
-	node->_needsUpdate = true;
 	ModelNode *root = node;
-	while (root->_parent) {
+	while (root->_parent)
 		root = root->_parent;
-		root->_needsUpdate = true;
-	}
+	root->update();
 
+	// The node matrices are relative to the actor
 	Math::Matrix4 matrix;
 	matrix.setPosition(actor->getPos());
 	matrix.buildFromPitchYawRoll(actor->getPitch(), actor->getYaw(), actor->getRoll());
-	root->setMatrix(matrix);
-	root->update();
-
 	Math::Vector3d pos(node->_pivotMatrix.getPosition());
+	matrix.transform(&pos, true);
 	lua_pushnumber(pos.x());
 	lua_pushnumber(pos.y());
 	lua_pushnumber(pos.z());
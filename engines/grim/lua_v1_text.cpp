@@ -31,6 +31,7 @@
 #include "engines/grim/resource.h"
 #include "engines/grim/inputdialog.h"
 #include "engines/grim/textobject.h"
+#include "engines/grim/gfx_base.h"
 
 #include "engines/grim/lua/lauxlib.h"
 
@@ -350,6 +351,7 @@ void Lua_V1::InputDialog() {
 	str += lua_getstring(messageObj);
 	Grim::InputDialog d(str, lua_getstring(defaultObj));
 	int res = d.runModal();
+	g_driver->invalidateScreen();
 	// The KeyUp event for CTRL has been eat by the gui loop, so we
 	// need to reset it manually.
 	g_grim->clearEventQueue();
@@ -177,6 +177,42 @@ MaterialData::~MaterialData() {
 	delete[] _textures;
 }
 
+void MaterialData::releaseTextures() {
+	bool reload = false;
+	for (int i = 0; i < _numImages; ++i) {
+		Texture *t = _textures + i;
+		if (t->_width && t->_height && t->_texture) {
+			g_driver->destroyMaterial(t);
+			t->_texture = NULL;
+			if (!t->_data)
+				reload = true;
+		}
+	}
+
+	if (!reload)
+		return;
+
+	// Material::select() throws away the pixel data once the texture is created,
+	// so read it again from the file.
+	Common::SeekableReadStream *data = g_resourceloader->openNewStreamFile(_fname.c_str(), true);
+	if (!data) {
+		warning("MaterialData::releaseTextures(): Could not reload material %s", _fname.c_str());
+		return;
+	}
+
+	for (int i = 0; i < _numImages; ++i) {
+		delete[] _textures[i]._data;
+	}
+	delete[] _textures;
+
+	if (g_grim->getGameType() == GType_MONKEY4) {
+		initEMI(data);
+	} else {
+		initGrim(data);
+	}
+	delete data;
+}
+
 MaterialData *MaterialData::getMaterialData(const Common::String &filename, Common::SeekableReadStream *data, CMap *cmap) {
 	if (!_materials) {
 		_materials = new Common::List<MaterialData *>();
@@ -48,6 +48,12 @@ public:
 	static MaterialData *getMaterialData(const Common::String &filename, Common::SeekableReadStream *data, CMap *cmap);
 	static Common::List<MaterialData *> *_materials;
 
+	/**
+	 * Destroy the textures created by the renderer, so that it can be replaced.
+	 * The textures are created again by the current renderer when selected.
+	 */
+	void releaseTextures();
+
 	Common::String _fname;
 	const ObjectPtr<CMap> _cmap;
 	int _numImages;
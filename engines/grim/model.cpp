@@ -85,7 +85,7 @@ Model::Model(const Common::String &filename, Common::SeekableReadStream *data, C
 		loadBinary(data);
 	else {
 		data->seek(0, SEEK_SET);
-		TextSplitter ts(data);
+		TextSplitter ts(_fname, data);
 		loadText(&ts);
 	}
 
@@ -239,8 +239,13 @@ void Model::loadText(TextSplitter *ts) {
 		_rootHierNode[num]._yaw = yaw;
 		_rootHierNode[num]._roll = roll;
 		_rootHierNode[num]._pivot = Math::Vector3d(pivotx, pivoty, pivotz);
+		_rootHierNode[num]._animPos.set(0, 0, 0);
+		_rootHierNode[num]._animPitch = 0;
+		_rootHierNode[num]._animYaw = 0;
+		_rootHierNode[num]._animRoll = 0;
 		_rootHierNode[num]._meshVisible = true;
 		_rootHierNode[num]._hierVisible = true;
+		_rootHierNode[num]._initialized = true;
 		_rootHierNode[num]._sprite = NULL;
 	}
 
@@ -249,6 +254,7 @@ void Model::loadText(TextSplitter *ts) {
 }
 
 void Model::draw() const {
+	_rootHierNode->update();
 	_rootHierNode->draw();
 }
 
@@ -381,14 +387,16 @@ void MeshFace::changeMaterial(Material *material) {
 	_material = material;
 }
 
-void MeshFace::draw(float *vertices, float *vertNormals, float *textureVerts) const {
-	if (_light == 0 && !g_driver->isShadowModeActive())
+void MeshFace::draw(float *vertices, float *vertNormals, float *textureVerts, bool meshLit) const {
+	// The lights are already off for the whole of an unlit mesh
+	bool unlit = meshLit && _light == 0 && !g_driver->isShadowModeActive();
+	if (unlit)
 		g_driver->disableLights();
 
 	_material->select();
 	g_driver->drawModelFace(this, vertices, vertNormals, textureVerts);
 
-	if (_light == 0 && !g_driver->isShadowModeActive())
+	if (unlit)
 		g_driver->enableLights();
 }
 
@@ -402,6 +410,11 @@ Mesh::~Mesh() {
 	delete[] _textureVerts;
 	delete[] _faces;
 	delete[] _materialid;
+	delete[] _drawOrder;
+	delete[] _drawFirst;
+	delete[] _drawVertices;
+	delete[] _drawNormals;
+	delete[] _drawTexVerts;
 }
 
 void Mesh::loadBinary(Common::SeekableReadStream *data, Material *materials[]) {
@@ -444,6 +457,8 @@ void Mesh::loadBinary(Common::SeekableReadStream *data, Material *materials[]) {
 	data->read(f, 4);
 	_radius = get_float(f);
 	data->seek(24, SEEK_CUR);
+
+	buildDrawArrays();
 }
 
 void Mesh::loadText(TextSplitter *ts, Material* materials[]) {
@@ -535,6 +550,67 @@ void Mesh::loadText(TextSplitter *ts, Material* materials[]) {
 		ts->scanString(" %d: %f %f %f", 4, &num, &x, &y, &z);
 		_faces[num]._normal = Math::Vector3d(x, y, z);
 	}
+
+	buildDrawArrays();
+}
+
+/**
+ * Sorts the faces by material, and lighting, and splits them in triangles
+ * stored in flat arrays, so that the faces sharing a material can be drawn
+ * with a single call.
+ */
+void Mesh::buildDrawArrays() {
+	_drawOrder = new int[_numFaces];
+	_drawFirst = new int[_numFaces + 1];
+
+	// Stable insertion sort, meshes only have a few hundred faces
+	for (int i = 0; i < _numFaces; i++) {
+		int material = _materialid[i];
+		bool lit = _faces[i]._light != 0;
+		int j = i;
+		while (j > 0) {
+			int prev = _drawOrder[j - 1];
+			bool prevLit = _faces[prev]._light != 0;
+			if (_materialid[prev] < material || (_materialid[prev] == material && prevLit <= lit))
+				break;
+			_drawOrder[j] = prev;
+			j--;
+		}
+		_drawOrder[j] = i;
+	}
+
+	int numVerts = 0;
+	for (int i = 0; i < _numFaces; i++) {
+		_drawFirst[i] = numVerts;
+		const MeshFace &face = _faces[_drawOrder[i]];
+		if (face._numVertices >= 3)
+			numVerts += 3 * (face._numVertices - 2);
+	}
+	_drawFirst[_numFaces] = numVerts;
+
+	_drawVertices = new float[3 * numVerts];
+	_drawNormals = new float[3 * numVerts];
+	_drawTexVerts = new float[2 * numVerts];
+
+	int v = 0;
+	for (int i = 0; i < _numFaces; i++) {
+		const MeshFace &face = _faces[_drawOrder[i]];
+		// The faces are convex polygons, draw them as triangle fans
+		for (int t = 1; t < face._numVertices - 1; t++) {
+			const int corners[3] = { 0, t, t + 1 };
+			for (int k = 0; k < 3; k++, v++) {
+				int vert = face._vertices[corners[k]];
+				memcpy(_drawVertices + 3 * v, _vertices + 3 * vert, 3 * sizeof(float));
+				memcpy(_drawNormals + 3 * v, _vertNormals + 3 * vert, 3 * sizeof(float));
+				if (face._texVertices) {
+					memcpy(_drawTexVerts + 2 * v, _textureVerts + 2 * face._texVertices[corners[k]], 2 * sizeof(float));
+				} else {
+					_drawTexVerts[2 * v] = 0.f;
+					_drawTexVerts[2 * v + 1] = 0.f;
+				}
+			}
+		}
+	}
 }
 
 void Mesh::update() {
@@ -549,8 +625,7 @@ void Mesh::draw() const {
 	if (_lightingMode == 0)
 		g_driver->disableLights();
 
-	for (int i = 0; i < _numFaces; i++)
-		_faces[i].draw(_vertices, _vertNormals, _textureVerts);
+	g_driver->drawMesh(this);
 
 	if (_lightingMode == 0)
 		g_driver->enableLights();
@@ -632,57 +707,56 @@ void ModelNode::loadBinary(Common::SeekableReadStream *data, ModelNode *hierNode
 	_initialized = true;
 }
 
+ModelNode *ModelNode::getNextNode(const ModelNode *stop, bool descend) const {
+	// Pre-order walk of the hierarchy: the parents always come before their children
+	if (descend && _child)
+		return _child;
+
+	const ModelNode *node = this;
+	while (node != stop && !node->_sibling)
+		node = node->_parent;
+	if (node == stop)
+		return NULL;
+	return node->_sibling;
+}
+
 void ModelNode::draw() const {
-	translateViewpoint();
-	if (_hierVisible) {
-		g_driver->translateViewpointStart();
-		g_driver->translateViewpoint(_pivot);
-
-		if (!g_driver->isShadowModeActive()) {
-			Sprite *sprite = _sprite;
-			while (sprite) {
-				sprite->draw();
-				sprite = sprite->_next;
+	// The matrices are relative to the root of the hierarchy, which the
+	// renderer already placed with startActorDraw()
+	const ModelNode *node = this;
+	while (node) {
+		if (node->_hierVisible) {
+			g_driver->translateViewpointStart();
+			g_driver->transformViewpoint(node->_pivotMatrix);
+
+			if (!g_driver->isShadowModeActive()) {
+				Sprite *sprite = node->_sprite;
+				while (sprite) {
+					sprite->draw();
+					sprite = sprite->_next;
+				}
 			}
-		}
 
-		if (_mesh && _meshVisible) {
-			_mesh->draw();
-		}
-
-		g_driver->translateViewpointFinish();
+			if (node->_mesh && node->_meshVisible) {
+				node->_mesh->draw();
+			}
 
-		if (_child) {
-			_child->draw();
+			g_driver->translateViewpointFinish();
 		}
-	}
-	translateViewpointBack();
-
-	if (_sibling) {
-		_sibling->draw();
+		node = node->getNextNode(_parent, node->_hierVisible);
 	}
 }
 
 void ModelNode::getBoundingBox(int *x1, int *y1, int *x2, int *y2) const {
-	translateViewpoint();
-	if (_hierVisible) {
-		g_driver->translateViewpointStart();
-		g_driver->translateViewpoint(_pivot);
-
-		if (_mesh && _meshVisible) {
-			_mesh->getBoundingBox(x1, y1, x2, y2);
+	const ModelNode *node = this;
+	while (node) {
+		if (node->_hierVisible && node->_mesh && node->_meshVisible) {
+			g_driver->translateViewpointStart();
+			g_driver->transformViewpoint(node->_pivotMatrix);
+			node->_mesh->getBoundingBox(x1, y1, x2, y2);
+			g_driver->translateViewpointFinish();
 		}
-
-		g_driver->translateViewpointFinish();
-
-		if (_child) {
-			_child->getBoundingBox(x1, y1, x2, y2);
-		}
-	}
-	translateViewpointBack();
-
-	if (_sibling) {
-		_sibling->getBoundingBox(x1, y1, x2, y2);
+		node = node->getNextNode(_parent, node->_hierVisible);
 	}
 }
 
@@ -692,6 +766,7 @@ void ModelNode::addChild(ModelNode *child) {
 		childPos = &(*childPos)->_sibling;
 	*childPos = child;
 	child->_parent = this;
+	child->invalidate();
 }
 
 void ModelNode::removeChild(ModelNode *child) {
@@ -701,47 +776,65 @@ void ModelNode::removeChild(ModelNode *child) {
 	if (*childPos) {
 		*childPos = child->_sibling;
 		child->_parent = NULL;
+		child->invalidate();
 	}
 }
 
-void ModelNode::setMatrix(const Math::Matrix4 &matrix) {
-	_matrix = matrix;
-	if (_sibling)
-		_sibling->setMatrix(matrix);
+void ModelNode::invalidate() {
+	_needsUpdate = true;
+	// The ancestors of a node flagged with _childNeedsUpdate are always flagged too
+	for (ModelNode *node = _parent; node && !node->_childNeedsUpdate; node = node->_parent)
+		node->_childNeedsUpdate = true;
 }
 
-void ModelNode::update() {
-	if (!_initialized)
-		return;
+void ModelNode::checkAnimation() {
+	Math::Vector3d animPos = _pos + _animPos;
+	if (_needsUpdate || animPos.x() != _localPos.x() || animPos.y() != _localPos.y() || animPos.z() != _localPos.z() ||
+	    (_pitch + _animPitch).getDegrees() != _localPitch || (_yaw + _animYaw).getDegrees() != _localYaw ||
+	    (_roll + _animRoll).getDegrees() != _localRoll)
+		invalidate();
+}
 
-	if (_hierVisible && _needsUpdate) {
-		Math::Vector3d animPos = _pos + _animPos;
-		Math::Angle animPitch = _pitch + _animPitch;
-		Math::Angle animYaw = _yaw + _animYaw;
-		Math::Angle animRoll = _roll + _animRoll;
+void ModelNode::updateMatrix() {
+	_localPos = _pos + _animPos;
+	_localPitch = (_pitch + _animPitch).getDegrees();
+	_localYaw = (_yaw + _animYaw).getDegrees();
+	_localRoll = (_roll + _animRoll).getDegrees();
 
-		_localMatrix.setPosition(animPos);
-		_localMatrix.buildFromPitchYawRoll(animPitch, animYaw, animRoll);
+	_localMatrix.setPosition(_localPos);
+	_localMatrix.buildFromPitchYawRoll(_localPitch, _localYaw, _localRoll);
 
-		_matrix = _matrix * _localMatrix;
+	if (_parent)
+		_matrix = _parent->_matrix * _localMatrix;
+	else
+		_matrix = _localMatrix;
 
-		_pivotMatrix = _matrix;
-		_pivotMatrix.translate(_pivot);
+	_pivotMatrix = _matrix;
+	_pivotMatrix.translate(_pivot);
 
-		if (_mesh) {
-			_mesh->_matrix = _pivotMatrix;
-		}
+	if (_mesh) {
+		_mesh->_matrix = _pivotMatrix;
+	}
 
-		if (_child) {
-			_child->setMatrix(_matrix);
-			_child->update();
-		}
+	for (ModelNode *child = _child; child; child = child->_sibling)
+		child->_needsUpdate = true;
+	_childNeedsUpdate = _child != NULL;
+	_needsUpdate = false;
+}
 
-		_needsUpdate = false;
-	}
+void ModelNode::update() {
+	if (!_initialized)
+		return;
 
-	if (_sibling) {
-		_sibling->update();
+	// The parents are always updated before their children, and the
+	// subtrees without invalidated nodes are skipped.
+	ModelNode *node = this;
+	while (node) {
+		if (node->_needsUpdate)
+			node->updateMatrix();
+		bool descend = node->_childNeedsUpdate;
+		node->_childNeedsUpdate = false;
+		node = node->getNextNode(_parent, descend);
 	}
 }
 
@@ -765,21 +858,4 @@ void ModelNode::removeSprite(Sprite *sprite) {
 	}
 }
 
-void ModelNode::translateViewpoint() const {
-	Math::Vector3d animPos = _pos + _animPos;
-	Math::Angle animPitch = _pitch + _animPitch;
-	Math::Angle animYaw = _yaw + _animYaw;
-	Math::Angle animRoll = _roll + _animRoll;
-	g_driver->translateViewpointStart();
-
-	g_driver->translateViewpoint(animPos);
-	g_driver->rotateViewpoint(animYaw, Math::Vector3d(0, 0, 1));
-	g_driver->rotateViewpoint(animPitch, Math::Vector3d(1, 0, 0));
-	g_driver->rotateViewpoint(animRoll, Math::Vector3d(0, 1, 0));
-}
-
-void ModelNode::translateViewpointBack() const {
-	g_driver->translateViewpointFinish();
-}
-
 } // end of namespace Grim
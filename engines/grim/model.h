@@ -102,7 +102,7 @@ public:
 class MeshFace {
 public:
 	int loadBinary(Common::SeekableReadStream *data, Material *materials[]);
-	void draw(float *vertices, float *vertNormals, float *textureVerts) const;
+	void draw(float *vertices, float *vertNormals, float *textureVerts, bool meshLit) const;
 	void changeMaterial(Material *material);
 	~MeshFace();
 
@@ -122,7 +122,7 @@ public:
 	void draw() const;
 	void getBoundingBox(int *x1, int *y1, int *x2, int *y2) const;
 	void update();
-	Mesh() : _numFaces(0) { }
+	Mesh() : _numFaces(0), _drawOrder(NULL), _drawFirst(NULL), _drawVertices(NULL), _drawNormals(NULL), _drawTexVerts(NULL) { }
 	~Mesh();
 
 	char _name[32];
@@ -141,23 +141,50 @@ public:
 	int _numFaces;
 	MeshFace *_faces;
 	Math::Matrix4 _matrix;
+
+	// The faces split in triangles and sorted by material, for the
+	// renderers that draw them with vertex arrays:
+	int *_drawOrder;       // face indices, in drawing order
+	int *_drawFirst;       // first vertex of every face in drawing order, _numFaces + 1 entries
+	float *_drawVertices;  // sets of 3
+	float *_drawNormals;   // sets of 3
+	float *_drawTexVerts;  // sets of 2
+
+private:
+	void buildDrawArrays();
 };
 
 class ModelNode {
 public:
-	ModelNode() : _initialized(false), _needsUpdate(true) { }
+	ModelNode() : _initialized(false), _needsUpdate(true), _childNeedsUpdate(false),
+		_localPitch(0), _localYaw(0), _localRoll(0) { }
 	~ModelNode();
 	void loadBinary(Common::SeekableReadStream *data, ModelNode *hierNodes, const Model::Geoset *g);
+	/**
+	 * Draws this node, its siblings and all their visible descendants with the
+	 * matrices computed by the last update().
+	 */
 	void draw() const;
 	void getBoundingBox(int *x1, int *y1, int *x2, int *y2) const;
 	void addChild(ModelNode *child);
 	void removeChild(ModelNode *child);
-	void setMatrix(const Math::Matrix4 &matrix);
+	/**
+	 * Updates the matrices of this node, its siblings and all their descendants.
+	 * The matrices are relative to the root of the hierarchy, i.e. to the actor
+	 * the model belongs to. Only the subtrees holding invalidated nodes are visited.
+	 */
 	void update();
+	/**
+	 * Marks the matrix of this node, and so those of its descendants, as out of date.
+	 */
+	void invalidate();
+	/**
+	 * Invalidates the node if its animated position or angles changed since
+	 * its matrix was built. Call it after changing _animPos or the angles.
+	 */
+	void checkAnimation();
 	void addSprite(Sprite *sprite);
 	void removeSprite(Sprite *sprite);
-	void translateViewpoint() const;
-	void translateViewpointBack() const;
 
 	char _name[64];
 	Mesh *_mesh;
@@ -183,11 +210,22 @@ public:
 	Math::Angle _animPitch, _animYaw, _animRoll;
 	bool _meshVisible, _hierVisible;
 	bool _initialized;
+	// Set when the matrix of this node is out of date
 	bool _needsUpdate;
+	// Set when the matrix of one of the descendants is out of date
+	bool _childNeedsUpdate;
 	Math::Matrix4 _matrix;
 	Math::Matrix4 _localMatrix;
 	Math::Matrix4 _pivotMatrix;
 	Sprite* _sprite;
+
+private:
+	void updateMatrix();
+	ModelNode *getNextNode(const ModelNode *stop, bool descend) const;
+
+	// The animated position and angles _localMatrix was built from
+	Math::Vector3d _localPos;
+	float _localPitch, _localYaw, _localRoll;
 };
 
 } // end of namespace Grim
@@ -85,9 +85,11 @@ MODULE_OBJS := \
 	costume.o \
 	color.o \
 	colormap.o \
+	console.o \
 	debug.o \
 	detection.o \
 	font.o \
+	framepacer.o \
 	gfx_base.o \
 	gfx_opengl.o \
 	gfx_tinygl.o \
@@ -118,6 +120,7 @@ MODULE_OBJS := \
 	sector.o \
 	sound.o \
 	stuffit.o \
+	textcache.o \
 	textobject.o \
 	textsplit.o \
 	object.o
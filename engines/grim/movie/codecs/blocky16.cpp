@@ -26,6 +26,14 @@
 
 #include "engines/grim/movie/codecs/blocky16.h"
 
+#if defined(__SSE2__)
+#define BLOCKY16_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLOCKY16_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Grim {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
@@ -85,6 +93,92 @@ namespace Grim {
 
 #endif
 
+#if defined(BLOCKY16_USE_SSE2)
+
+// A row of a 2-colour glyph: the pixels whose bit is set in the mask get c1,
+// the others c2
+static inline __m128i glyphLine(byte mask, uint16 c1, uint16 c2) {
+	const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+	__m128i sel = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(mask), bits), bits);
+	return _mm_or_si128(_mm_and_si128(sel, _mm_set1_epi16((int16)c1)), _mm_andnot_si128(sel, _mm_set1_epi16((int16)c2)));
+}
+
+#define COPY_8X1_LINE(dst, src)		\
+	_mm_storel_epi64((__m128i *)(dst), _mm_loadl_epi64((const __m128i *)(src)))
+
+#define COPY_16X1_LINE(dst, src)		\
+	_mm_storeu_si128((__m128i *)(dst), _mm_loadu_si128((const __m128i *)(src)))
+
+#define WRITE_8X1_LINE(dst, v)		\
+	_mm_storel_epi64((__m128i *)(dst), _mm_set1_epi32(v))
+
+#define WRITE_16X1_LINE(dst, v)		\
+	_mm_storeu_si128((__m128i *)(dst), _mm_set1_epi32(v))
+
+#define GLYPH_8X1_LINE(dst, mask, c1, c2)		\
+	_mm_storel_epi64((__m128i *)(dst), glyphLine(mask, c1, c2))
+
+#define GLYPH_16X1_LINE(dst, mask, c1, c2)		\
+	_mm_storeu_si128((__m128i *)(dst), glyphLine(mask, c1, c2))
+
+#elif defined(BLOCKY16_USE_NEON)
+
+static inline uint16x8_t glyphLine(byte mask, uint16 c1, uint16 c2) {
+	static const uint16 bits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint16x8_t sel = vtstq_u16(vdupq_n_u16(mask), vld1q_u16(bits));
+	return vbslq_u16(sel, vdupq_n_u16(c1), vdupq_n_u16(c2));
+}
+
+#define COPY_8X1_LINE(dst, src)		\
+	vst1_u8((dst), vld1_u8(src))
+
+#define COPY_16X1_LINE(dst, src)		\
+	vst1q_u8((dst), vld1q_u8(src))
+
+#define WRITE_8X1_LINE(dst, v)		\
+	vst1_u8((dst), vreinterpret_u8_u32(vdup_n_u32(v)))
+
+#define WRITE_16X1_LINE(dst, v)		\
+	vst1q_u8((dst), vreinterpretq_u8_u32(vdupq_n_u32(v)))
+
+#define GLYPH_8X1_LINE(dst, mask, c1, c2)		\
+	vst1_u8((dst), vreinterpret_u8_u16(vget_low_u16(glyphLine(mask, c1, c2))))
+
+#define GLYPH_16X1_LINE(dst, mask, c1, c2)		\
+	vst1q_u8((dst), vreinterpretq_u8_u16(glyphLine(mask, c1, c2)))
+
+#else
+
+#define COPY_8X1_LINE(dst, src)		\
+	do {				\
+		COPY_4X1_LINE((dst) + 0, (src) + 0);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define COPY_16X1_LINE(dst, src)		\
+	do {				\
+		COPY_8X1_LINE((dst) + 0, (src) + 0);	\
+		COPY_8X1_LINE((dst) + 8, (src) + 8);	\
+	} while (0)
+
+#define WRITE_8X1_LINE(dst, v)		\
+	do {				\
+		WRITE_4X1_LINE((dst) + 0, v);	\
+		WRITE_4X1_LINE((dst) + 4, v);	\
+	} while (0)
+
+#define WRITE_16X1_LINE(dst, v)		\
+	do {				\
+		WRITE_8X1_LINE((dst) + 0, v);	\
+		WRITE_8X1_LINE((dst) + 8, v);	\
+	} while (0)
+
+#endif
+
+#if defined(BLOCKY16_USE_SSE2) || defined(BLOCKY16_USE_NEON)
+#define BLOCKY16_USE_SIMD
+#endif
+
 static int8 blocky16_table_small1[] = {
 	0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -196,6 +290,9 @@ void Blocky16::makeTablesInterpolation(int param) {
 		error("Blocky16::makeTablesInterpolation: unknown param %d", param);
 	}
 
+	byte *glyphMasks = (param == 8) ? &_glyphMasksBig[0][0] : &_glyphMasksSmall[0][0];
+	memset(glyphMasks, 0, 256 * param);
+
 	s = 0;
 	for (x = 0; x < 16; x++) {
 		value_table47_1_1 = table47_1[x];
@@ -286,6 +383,12 @@ void Blocky16::makeTablesInterpolation(int param) {
 				}
 			}
 
+			for (i = 0; i < param * param; i++) {
+				if (tableSmallBig[i] != 0)
+					glyphMasks[i / param] |= 1 << (i % param);
+			}
+			glyphMasks += param;
+
 			if (param == 8) {
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
@@ -443,8 +546,7 @@ void Blocky16::level2(byte *d_dst) {
 		}
 		tmp2 += _offset1;
 		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -458,8 +560,7 @@ void Blocky16::level2(byte *d_dst) {
 	} else if (code == 0xF6) {
 		tmp2 = _offset2;
 		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if ((code == 0xF7) || (code == 0xF8)) {
@@ -473,6 +574,13 @@ void Blocky16::level2(byte *d_dst) {
 			val |= READ_LE_UINT16(_param6_7Ptr + (byte)tmp2 * 2);
 			_d_src += 2;
 		}
+#if defined(BLOCKY16_USE_SIMD)
+		const byte *mask = _glyphMasksSmall[tmp];
+		for (i = 0; i < 4; i++) {
+			GLYPH_8X1_LINE(d_dst, mask[i], (uint16)val, (uint16)(val >> 16));
+			d_dst += _d_pitch;
+		}
+#else
 		byte *tmp_ptr = _tableSmall + (tmp * 128);
 		byte l = tmp_ptr[96];
 		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
@@ -487,6 +595,7 @@ void Blocky16::level2(byte *d_dst) {
 			WRITE_2X1_LINE(d_dst + READ_LE_UINT16(tmp_ptr2) * 2, val);
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code >= 0xF9) {
 		if (code == 0xFD) {
 			t = *_d_src++;
@@ -501,8 +610,7 @@ void Blocky16::level2(byte *d_dst) {
 			t = (t << 16) | t;
 		}
 		for (i = 0; i < 4; i++) {
-			WRITE_4X1_LINE(d_dst + 0, t);
-			WRITE_4X1_LINE(d_dst + 4, t);
+			WRITE_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -524,10 +632,7 @@ void Blocky16::level1(byte *d_dst) {
 		}
 		tmp2 += _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			COPY_4X1_LINE(d_dst +  8, d_dst + tmp2 +  8);
-			COPY_4X1_LINE(d_dst + 12, d_dst + tmp2 + 12);
+			COPY_16X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -541,10 +646,7 @@ void Blocky16::level1(byte *d_dst) {
 	} else if (code == 0xF6) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			COPY_4X1_LINE(d_dst +  8, d_dst + tmp2 +  8);
-			COPY_4X1_LINE(d_dst + 12, d_dst + tmp2 + 12);
+			COPY_16X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if ((code == 0xF7) || (code == 0xF8)) {
@@ -558,6 +660,13 @@ void Blocky16::level1(byte *d_dst) {
 			val |= READ_LE_UINT16(_param6_7Ptr + (byte)tmp2 * 2);
 			_d_src += 2;
 		}
+#if defined(BLOCKY16_USE_SIMD)
+		const byte *mask = _glyphMasksBig[tmp];
+		for (i = 0; i < 8; i++) {
+			GLYPH_16X1_LINE(d_dst, mask[i], (uint16)val, (uint16)(val >> 16));
+			d_dst += _d_pitch;
+		}
+#else
 		byte *tmp_ptr = _tableBig + (tmp * 388);
 		byte l = tmp_ptr[384];
 		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
@@ -572,6 +681,7 @@ void Blocky16::level1(byte *d_dst) {
 			WRITE_2X1_LINE(d_dst + READ_LE_UINT16(tmp_ptr2) * 2, val);
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code >= 0xF9) {
 		if (code == 0xFD) {
 			t = *_d_src++;
@@ -586,10 +696,7 @@ void Blocky16::level1(byte *d_dst) {
 			t = (t << 16) | t;
 		}
 		for (i = 0; i < 8; i++) {
-			WRITE_4X1_LINE(d_dst +  0, t);
-			WRITE_4X1_LINE(d_dst +  4, t);
-			WRITE_4X1_LINE(d_dst +  8, t);
-			WRITE_4X1_LINE(d_dst + 12, t);
+			WRITE_16X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -42,6 +42,9 @@ private:
 	byte *_tableBig;
 	byte *_tableSmall;
 	int16 _table[256];
+	/** Rows of the 2-colour glyphs, with a bit set for the pixels of the first colour. */
+	byte _glyphMasksBig[256][8];
+	byte _glyphMasksSmall[256][4];
 	int32 _frameSize;
 	int _width, _height;
 
@@ -27,6 +27,14 @@
 
 #include "engines/grim/movie/codecs/blocky8.h"
 
+#if defined(__SSE2__)
+#define BLOCKY8_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLOCKY8_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Grim {
 
 #if defined(SYSTEM_NEED_ALIGNMENT)
@@ -70,6 +78,58 @@ namespace Grim {
 		(dst)[1] = val;	\
 	} while (0)
 
+#if defined(BLOCKY8_USE_SSE2)
+
+// A row of a 2-colour glyph: the pixels whose bit is set in the mask get c1,
+// the others c2
+static inline __m128i glyphLine(byte mask, byte c1, byte c2) {
+	const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+	__m128i sel = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((int8)mask), bits), bits);
+	return _mm_or_si128(_mm_and_si128(sel, _mm_set1_epi8((int8)c1)), _mm_andnot_si128(sel, _mm_set1_epi8((int8)c2)));
+}
+
+#define COPY_8X1_LINE(dst, src)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_loadl_epi64((const __m128i *)(src)))
+
+#define FILL_8X1_LINE(dst, val)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_set1_epi8((int8)(val)))
+
+#define GLYPH_8X1_LINE(dst, mask, c1, c2)			\
+	_mm_storel_epi64((__m128i *)(dst), glyphLine(mask, c1, c2))
+
+#elif defined(BLOCKY8_USE_NEON)
+
+static inline uint8x8_t glyphLine(byte mask, byte c1, byte c2) {
+	static const uint8 bits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x8_t sel = vtst_u8(vdup_n_u8(mask), vld1_u8(bits));
+	return vbsl_u8(sel, vdup_n_u8(c1), vdup_n_u8(c2));
+}
+
+#define COPY_8X1_LINE(dst, src)			\
+	vst1_u8((dst), vld1_u8(src))
+
+#define FILL_8X1_LINE(dst, val)			\
+	vst1_u8((dst), vdup_n_u8(val))
+
+#define GLYPH_8X1_LINE(dst, mask, c1, c2)			\
+	vst1_u8((dst), glyphLine(mask, c1, c2))
+
+#else
+
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE((dst) + 0, (src) + 0);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define FILL_8X1_LINE(dst, val)			\
+	do {					\
+		FILL_4X1_LINE((dst) + 0, val);	\
+		FILL_4X1_LINE((dst) + 4, val);	\
+	} while (0)
+
+#endif
+
 static const int8 blocky8_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -173,6 +233,9 @@ void Blocky8::makeTablesInterpolation(int param) {
 		error("Blocky8::makeTablesInterpolation: unknown param %d", param);
 	}
 
+	if (param == 8)
+		memset(_glyphMasks, 0, sizeof(_glyphMasks));
+
 	s = 0;
 	for (x = 0; x < 16; x++) {
 		value_table47_1_1 = table47_1[x];
@@ -264,6 +327,10 @@ void Blocky8::makeTablesInterpolation(int param) {
 			}
 
 			if (param == 8) {
+				for (i = 0; i < 64; i++) {
+					if (tableSmallBig[i] != 0)
+						_glyphMasks[x * 16 + y][i / 8] |= 1 << (i % 8);
+				}
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
 						_tableBig[256 + s + _tableBig[384 + s]] = (byte)i;
@@ -452,8 +519,7 @@ void Blocky8::level1(byte *d_dst) {
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -467,12 +533,20 @@ void Blocky8::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
 		tmp = *_d_src++;
+#if defined(BLOCKY8_USE_SSE2) || defined(BLOCKY8_USE_NEON)
+		const byte *mask = _glyphMasks[tmp];
+		byte val1 = *_d_src++;
+		byte val2 = *_d_src++;
+		for (i = 0; i < 8; i++) {
+			GLYPH_8X1_LINE(d_dst, mask[i], val1, val2);
+			d_dst += _d_pitch;
+		}
+#else
 		byte *tmp_ptr = _tableBig + tmp * 388;
 		byte l = tmp_ptr[384];
 		byte val = *_d_src++;
@@ -488,18 +562,17 @@ void Blocky8::level1(byte *d_dst) {
 			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -42,6 +42,8 @@ private:
 	byte *_tableBig;
 	byte *_tableSmall;
 	int16 _table[256];
+	/** Rows of the big 2-colour glyphs, with a bit set for the pixels of the first colour. */
+	byte _glyphMasks[256][8];
 	int32 _frameSize;
 	int _width, _height;
 
@@ -44,8 +44,6 @@ namespace Grim {
 #define BUFFER_SIZE 16385
 #define SMUSH_SPEED 66667
 
-static uint16 smushDestTable[5786];
-
 SmushDecoder::SmushDecoder() {
 	// Set colour-format statically here for SMUSH (5650), to allow for differing
 	// PixelFormat in engine and renderer (and conversion from Surface there)
@@ -78,7 +76,7 @@ void SmushDecoder::init() {
 
 	if (!_demo) {
 		_surface.create(_width, _height, _format);
-		vimaInit(smushDestTable);
+		vimaInit();
 	}
 }
 
@@ -91,6 +89,7 @@ void SmushDecoder::close() {
 	}
 	_videoLooping = false;
 	_videoPause = true;
+	_frameIndex.clear();
 	if (_file) {
 		delete _file;
 		_file = NULL;
@@ -99,7 +98,7 @@ void SmushDecoder::close() {
 
 void SmushDecoder::handleWave(const byte *src, uint32 size) {
 	int16 *dst = (int16 *) malloc(size * _channels * sizeof(int16));
-	decompressVima(src, dst, size * _channels * 2, smushDestTable);
+	decompressVima(src, dst, size * _channels * 2);
 
 	int flags = Audio::FLAG_16BITS;
 	if (_channels == 2)
@@ -117,10 +116,6 @@ void SmushDecoder::handleWave(const byte *src, uint32 size) {
 }
 
 void SmushDecoder::handleFrame() {
-	uint32 tag;
-	int32 size;
-	int pos = 0;
-
 	if (_videoLooping && _curFrame == _nbframes - 1) {
 		_file->seek(_startPos, SEEK_SET);
 		_curFrame = -1;
@@ -137,6 +132,17 @@ void SmushDecoder::handleFrame() {
 		return;
 	}
 
+	readFrame(true);
+	++_curFrame;
+}
+
+void SmushDecoder::readFrame(bool withAudio) {
+	uint32 tag;
+	int32 size;
+	int pos = 0;
+	int32 framePos = _file->pos();
+	bool keyFrame = false;
+
 	tag = _file->readUint32BE();
 	if (tag == MKTAG('A','N','N','O')) {
 		char *anno;
@@ -175,14 +181,20 @@ void SmushDecoder::handleFrame() {
 
 	do {
 		if (READ_BE_UINT32(frame + pos) == MKTAG('B','l','1','6')) {
+			// A sequence number of 0 resets the delta buffers, so the frames
+			// from there on don't need the earlier ones
+			if (READ_LE_UINT16(frame + pos + 8 + 16) == 0)
+				keyFrame = true;
 			_blocky16->decode((byte *)_surface.pixels, frame + pos + 8);
 			pos += READ_BE_UINT32(frame + pos + 4) + 8;
 		} else if (READ_BE_UINT32(frame + pos) == MKTAG('W','a','v','e')) {
-			int decompressed_size = READ_BE_UINT32(frame + pos + 8);
-			if (decompressed_size < 0)
-				handleWave(frame + pos + 8 + 4 + 8, READ_BE_UINT32(frame + pos + 8 + 8));
-			else
-				handleWave(frame + pos + 8 + 4, decompressed_size);
+			if (withAudio) {
+				int decompressed_size = READ_BE_UINT32(frame + pos + 8);
+				if (decompressed_size < 0)
+					handleWave(frame + pos + 8 + 4 + 8, READ_BE_UINT32(frame + pos + 8 + 8));
+				else
+					handleWave(frame + pos + 8 + 4, decompressed_size);
+			}
 			pos += READ_BE_UINT32(frame + pos + 4) + 8;
 		} else {
 			Debug::error(Debug::Movie, "SmushDecoder::handleFrame() unknown tag");
@@ -190,7 +202,22 @@ void SmushDecoder::handleFrame() {
 	} while (pos < size);
 	delete[] frame;
 
-	++_curFrame;
+	addFrameToIndex(framePos, keyFrame);
+}
+
+void SmushDecoder::addFrameToIndex(int32 pos, bool keyFrame) {
+	// Only the frames read for the first time are new
+	int32 frame = _curFrame + 1;
+	if (frame != (int32)_frameIndex.size())
+		return;
+
+	FrameIndexEntry entry;
+	entry.pos = pos;
+	if (frame == 0)
+		entry.keyFrame = 0;
+	else
+		entry.keyFrame = keyFrame ? frame : _frameIndex.back().keyFrame;
+	_frameIndex.push_back(entry);
 }
 
 static byte delta_color(byte org_color, int16 delta_color) {
@@ -279,10 +306,6 @@ void SmushDecoder::handleIACT(const byte *src, int32 size) {
 }
 
 void SmushDecoder::handleFrameDemo() {
-	uint32 tag;
-	int32 size;
-	int pos = 0;
-
 	if (_videoPause)
 		return;
 
@@ -294,6 +317,16 @@ void SmushDecoder::handleFrameDemo() {
 	if (_curFrame == -1)
 		_startTime = g_system->getMillis();
 
+	readFrameDemo(true);
+	_curFrame++;
+}
+
+void SmushDecoder::readFrameDemo(bool withAudio) {
+	uint32 tag;
+	int32 size;
+	int pos = 0;
+	int32 framePos = _file->pos();
+
 	tag = _file->readUint32BE();
 	assert(tag == MKTAG('F','R','M','E'));
 	size = _file->readUint32BE();
@@ -315,7 +348,8 @@ void SmushDecoder::handleFrameDemo() {
 			_blocky8->decode((byte *)_surface.pixels, frame + pos + 8 + 14);
 			pos += READ_BE_UINT32(frame + pos + 4) + 8;
 		} else if (READ_BE_UINT32(frame + pos) == MKTAG('I','A','C','T')) {
-			handleIACT(frame + pos + 8, READ_BE_UINT32(frame + pos + 4));
+			if (withAudio)
+				handleIACT(frame + pos + 8, READ_BE_UINT32(frame + pos + 4));
 			int offset = READ_BE_UINT32(frame + pos + 4) + 8;
 			if (offset & 1)
 				offset += 1;
@@ -329,6 +363,9 @@ void SmushDecoder::handleFrameDemo() {
 	} while (pos < size);
 	delete[] frame;
 
+	// The palette of the demo videos is delta coded from the start
+	addFrameToIndex(framePos, false);
+
 	Graphics::Surface conversion;
 	conversion.create(0, 0, _format); // Avoid issues with copyFrom, by creating an empty surface.
 	conversion.copyFrom(_surface);
@@ -339,8 +376,6 @@ void SmushDecoder::handleFrameDemo() {
 		d[l] = ((_pal[(index * 3) + 0] & 0xF8) << 8) | ((_pal[(index * 3) + 1] & 0xFC) << 3) | (_pal[(index * 3) + 2] >> 3);
 	}
 	conversion.free();
-
-	_curFrame++;
 }
 
 void SmushDecoder::handleFramesHeader() {
@@ -386,6 +421,7 @@ bool SmushDecoder::setupAnimDemo() {
 	for (int l = 0; l < 0x300; l++) {
 		_pal[l] = _file->readByte();
 	}
+	memcpy(_startPal, _pal, 0x300);
 	_file->readUint32BE();
 	_file->readUint32BE();
 	_file->readUint32BE();
@@ -500,43 +536,46 @@ void SmushDecoder::setMsPerFrame(int ms) {
 	_frameRate = Common::Rational(1000000, ms);
 }
 
-void SmushDecoder::seekToTime(const Audio::Timestamp &time) { // FIXME: This will be off by a second or two right now.
-	int32 wantedFrame = (uint32) ((time.msecs() / 1000.0f) * getFrameRate().toDouble());
-	warning("Seek to time: %d, frame: %d", time.msecs(), wantedFrame);
-	warning("Current frame: %d", _curFrame);
-	uint32 tag;
-	int32 size;
+void SmushDecoder::seekToTime(const Audio::Timestamp &time) {
+	// In 64 bits, as the time is in milliseconds
+	const Common::Rational frameRate = getFrameRate();
+	int32 wantedFrame = (int32)((uint64)time.msecs() * frameRate.getNumerator() / ((uint64)frameRate.getDenominator() * 1000));
+	Debug::debug(Debug::Movie, "Seek to time: %d, frame: %d, current frame: %d\n", time.msecs(), wantedFrame, _curFrame);
+
+	if (wantedFrame >= _nbframes)
+		return;
 
 	if (_stream) {
 		_stream->finish();
 		_stream = NULL;
+		g_system->getMixer()->stopHandle(_soundHandle);
 	}
 
-	if (wantedFrame > _nbframes)
-		return;
-
-	if (wantedFrame < _curFrame) {
-		_file->seek(_startPos, SEEK_SET);
+	// Rebuild the codec state from the last self-contained frame before the
+	// wanted one, unless the current position is closer already. The frames
+	// past the index were never read, they are reached by decoding forward
+	// from the last key frame read, which also indexes them.
+	int32 indexedFrame = MIN<int32>(wantedFrame, (int32)_frameIndex.size() - 1);
+	int32 startFrame = indexedFrame >= 0 ? _frameIndex[indexedFrame].keyFrame : 0;
+	if (_curFrame < startFrame - 1 || _curFrame >= wantedFrame) {
+		_file->seek(indexedFrame >= 0 ? _frameIndex[startFrame].pos : _startPos, SEEK_SET);
+		_curFrame = startFrame - 1;
+		if (_demo && startFrame == 0)
+			memcpy(_pal, _startPal, 0x300);
 	}
+	_IACTpos = 0;
 
-	_videoPause = true;
-	_startTime = g_system->getMillis() - time.msecs(); // This won't be correct, as we should round off to the frame-start.
-
-	while(_curFrame < wantedFrame) {
-		tag = _file->readUint32BE();
-		if (tag == MKTAG('A','N','N','O')) {
-			size = _file->readUint32BE();
-			_file->seek(size, SEEK_CUR);
-			tag = _file->readUint32BE();
-
-		}
-		assert(tag == MKTAG('F','R','M','E'));
-		size = _file->readUint32BE();
-		_file->seek(size, SEEK_CUR);
+	while (_curFrame < wantedFrame - 1) {
+		if (_demo)
+			readFrameDemo(false);
+		else
+			readFrame(false);
 		_curFrame++;
 	}
 
-	warning("Seek complete");
+	// The wanted frame is the next one to decode, and due right away
+	uint32 beginTime = (uint32)((uint64)wantedFrame * 1000 * frameRate.getDenominator() / frameRate.getNumerator());
+	_startTime = g_system->getMillis() - beginTime;
 	_videoPause = false;
 }
 
@@ -23,6 +23,7 @@
 #ifndef GRIM_SMUSH_DECODER_H
 #define GRIM_SMUSH_DECODER_H
 
+#include "common/array.h"
 #include "common/rational.h"
 
 #include "audio/mixer.h"
@@ -53,10 +54,22 @@ private:
 	Graphics::PixelFormat _format;
 
 	byte _pal[0x300];
+	byte _startPal[0x300];
 	int16 _deltaPal[0x300];
 	byte _IACToutput[4096];
 	int32 _IACTpos;
 
+	/**
+	 * Position of a frame in the file, and the last frame before it that
+	 * can be decoded without the preceding ones. The frames are added as
+	 * they are read, so the index only covers the ones read so far.
+	 */
+	struct FrameIndexEntry {
+		int32 pos;
+		int32 keyFrame;
+	};
+	Common::Array<FrameIndexEntry> _frameIndex;
+
 	Audio::SoundHandle _soundHandle;
 	Audio::QueuingAudioStream *_stream;
 
@@ -102,6 +115,9 @@ private:
 	void handleFramesHeader();
 	void handleFrameDemo();
 	void handleFrame();
+	void readFrame(bool withAudio);
+	void readFrameDemo(bool withAudio);
+	void addFrameToIndex(int32 pos, bool keyFrame);
 	void handleBlocky16(byte *src);
 	void handleWave(const byte *src, uint32 size);
 	void handleIACT(const byte *src, int32 size);
@@ -21,6 +21,9 @@
  */
 
 #include "common/endian.h"
+#include "common/util.h"
+
+#include "engines/grim/movie/codecs/vima.h"
 
 namespace Grim {
 
@@ -99,25 +102,64 @@ static int8 *offsets[] = {
 	imcOtherTable4, imcOtherTable5, imcOtherTable6
 };
 
-void vimaInit(uint16 *destTable) {
-	int destTableStartPos, incer;
-
-	for (destTableStartPos = 0, incer = 0; destTableStartPos < 64; destTableStartPos++, incer++) {
-		unsigned int destTablePos, imcTable1Pos;
-		for (imcTable1Pos = 0, destTablePos = destTableStartPos;
-				imcTable1Pos < sizeof(imcTable1) / sizeof(imcTable1[0]); imcTable1Pos++, destTablePos += 64) {
-			int put = 0, count, tableValue;
-			for (count = 32, tableValue = imcTable1[imcTable1Pos]; count != 0; count >>= 1, tableValue >>= 1) {
-				if (incer & count) {
-					put += tableValue;
-				}
+enum {
+	kNumPositions = 89,
+	kEscapeCode = 0x80,
+	kPositionMask = 0x7f
+};
+
+// For every step index and code, the signed delta to add to the sample
+// (bits 8 and up), whether the code escapes to a literal sample, and the
+// next step index. The codes of a step index are numbered from
+// vimaStepBase[index], there are 1 << imcTable2[index] of them.
+static int32 vimaSteps[4048];
+static uint16 vimaStepBase[kNumPositions];
+
+void vimaInit() {
+	static bool initialized = false;
+	if (initialized)
+		return;
+	initialized = true;
+
+	int base = 0;
+	for (int pos = 0; pos < kNumPositions; pos++) {
+		const int numBits = imcTable2[pos];
+		const int highBit = 1 << (numBits - 1);
+		const int lowBits = highBit - 1;
+		vimaStepBase[pos] = base;
+
+		for (int code = 0; code < (1 << numBits); code++) {
+			const int val = code & lowBits;
+
+			int nextPos = pos + offsets[numBits - 2][val];
+			nextPos = CLIP(nextPos, 0, kNumPositions - 1);
+
+			if (val == lowBits) {
+				vimaSteps[base + code] = kEscapeCode | nextPos;
+				continue;
+			}
+
+			// Sum of the step shifted right by one more for each bit of the
+			// value, as read from the top
+			const int incer = val << (7 - numBits);
+			int delta = 0;
+			for (int count = 32, tableValue = imcTable1[pos]; count != 0; count >>= 1, tableValue >>= 1) {
+				if (incer & count)
+					delta += tableValue;
 			}
-			destTable[destTablePos] = put;
+			if (val)
+				delta += imcTable1[pos] >> (numBits - 1);
+			if (code & highBit)
+				delta = -delta;
+
+			vimaSteps[base + code] = (delta * 256) | nextPos;
 		}
+		base += 1 << numBits;
 	}
+	assert(base == ARRAYSIZE(vimaSteps));
 }
 
-void decompressVima(const byte *src, int16 *dest, int destLen, uint16 *destTable) {
+void decompressVima(const byte *src, int16 *dest, int destLen) {
 	int numChannels = 1;
 	byte sBytes[2];
 	int16 sWords[2];
@@ -135,63 +177,43 @@ void decompressVima(const byte *src, int16 *dest, int destLen, uint16 *destTable
 		src += 2;
 	}
 
-	int numSamples = destLen / (numChannels * 2);
-	int bits = READ_BE_UINT16(src);
-	int bitPtr = 0;
+	const int numSamples = destLen / (numChannels * 2);
+
+	// The unread bits are the lowest 'avail' ones. The input is read a byte
+	// at a time when less than 9 bits are left, as the caller doesn't tell
+	// how long it is and reading further could run past its end.
+	uint32 bits = READ_BE_UINT16(src);
+	int avail = 16;
 	src += 2;
 
+	// The channels follow each other in the stream
 	for (int channel = 0; channel < numChannels; channel++) {
 		int16 *destPos = dest + channel;
-		int currTablePos = sBytes[channel];
+		int pos = sBytes[channel];
 		int outputWord = sWords[channel];
 
 		for (int sample = 0; sample < numSamples; sample++) {
-			int numBits = imcTable2[currTablePos];
-			bitPtr += numBits;
-			int highBit = 1 << (numBits - 1);
-			int lowBits = highBit - 1;
-			int val = (bits >> (16 - bitPtr)) & (highBit | lowBits);
-
-			if (bitPtr > 7) {
-				bits = ((bits & 0xff) << 8) | *src++;
-				bitPtr -= 8;
+			const int numBits = imcTable2[pos];
+			avail -= numBits;
+			const int code = (bits >> avail) & ((1 << numBits) - 1);
+			if (avail < 9) {
+				bits = (bits << 8) | *src++;
+				avail += 8;
 			}
 
-			if (val & highBit)
-				val ^= highBit;
-			else
-				highBit = 0;
-
-			if (val == lowBits) {
-				outputWord = ((int16)(bits << bitPtr) & 0xffffff00);
-				bits = ((bits & 0xff) << 8) | *src++;
-				outputWord |= ((bits >> (8 - bitPtr)) & 0xff);
-				bits = ((bits & 0xff) << 8) | *src++;
+			const int32 step = vimaSteps[vimaStepBase[pos] + code];
+			if (step & kEscapeCode) {
+				bits = (bits << 16) | READ_BE_UINT16(src);
+				src += 2;
+				outputWord = (int16)(bits >> avail);
 			} else {
-				int index = (val << (7 - numBits)) | (currTablePos << 6);
-				int delta = destTable[index];
-
-				if (val)
-					delta += (imcTable1[currTablePos] >> (numBits - 1));
-				if (highBit)
-					delta = -delta;
-
-				outputWord += delta;
-				if (outputWord < -0x8000)
-					outputWord = -0x8000;
-				else if (outputWord > 0x7fff)
-					outputWord = 0x7fff;
+				outputWord = CLIP(outputWord + (step >> 8), -0x8000, 0x7fff);
 			}
 
 			WRITE_BE_UINT16(destPos, outputWord);
 			destPos += numChannels;
 
-			currTablePos += offsets[numBits - 2][val];
-
-			if (currTablePos < 0)
-				currTablePos = 0;
-			else if (currTablePos > 88)
-				currTablePos = 88;
+			pos = step & kPositionMask;
 		}
 	}
 }
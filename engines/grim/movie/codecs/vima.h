@@ -25,8 +25,21 @@
 
 namespace Grim {
 
-void vimaInit(uint16 *destTable);
-void decompressVima(const byte *src, int16 *dest, int destLen, uint16 *destTable);
+/**
+ * Build the decoding tables. Call this before the first decompressVima(),
+ * any further call does nothing.
+ */
+void vimaInit();
+
+/**
+ * Decode a VIMA (IMA ADPCM variant) block into big endian 16 bit samples,
+ * interleaved for stereo blocks.
+ *
+ * @param src		the compressed block, starting with its header
+ * @param dest		the buffer for the samples
+ * @param destLen	the size of the samples to decode, in bytes
+ */
+void decompressVima(const byte *src, int16 *dest, int destLen);
 
 } // end of namespace Grim
 
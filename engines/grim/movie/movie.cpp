@@ -49,13 +49,21 @@ MoviePlayer::MoviePlayer() {
 	_internalSurface = NULL;
 	_externalSurface = new Graphics::Surface();
 	_timerStarted = false;
+	_queueHead = 0;
+	_queueCount = 0;
+	_decodeFinished = false;
+	_pauseTime = 0;
+	_droppedFrames = 0;
+	_lateFrames = 0;
 }
 
 MoviePlayer::~MoviePlayer() {
-	// Remove the callback immediately, so we're sure timerCallback() doesn't get called
+	// Remove the callbacks immediately, so we're sure they don't get called
 	// after the deinit() or the deletes.
-	if (_timerStarted)
+	if (_timerStarted) {
 		g_system->getTimerManager()->removeTimerProc(&timerCallback);
+		g_system->getTimerManager()->removeTimerProc(&decodeCallback);
+	}
 
 	deinit();
 	delete _videoDecoder;
@@ -63,12 +71,26 @@ MoviePlayer::~MoviePlayer() {
 }
 
 void MoviePlayer::pause(bool p) {
+	Common::StackLock decodeLock(_decodeMutex);
 	Common::StackLock lock(_frameMutex);
+	if (p == _videoPause)
+		return;
+
 	_videoPause = p;
 	_videoDecoder->pauseVideo(p);
+
+	// The queued frames are due that much later
+	if (p) {
+		_pauseTime = g_system->getMillis();
+	} else {
+		const uint32 pausedTime = g_system->getMillis() - _pauseTime;
+		for (int i = 0; i < _queueCount; ++i)
+			_frameQueue[(_queueHead + i) % kFrameQueueSize].dueTime += pausedTime;
+	}
 }
 
 void MoviePlayer::stop() {
+	Common::StackLock decodeLock(_decodeMutex);
 	Common::StackLock lock(_frameMutex);
 	deinit();
 	g_grim->setMode(GrimEngine::NormalMode);
@@ -77,18 +99,82 @@ void MoviePlayer::stop() {
 void MoviePlayer::timerCallback(void *instance) {
 	MoviePlayer *movie = static_cast<MoviePlayer *>(instance);
 	Common::StackLock lock(movie->_frameMutex);
-	if (movie->prepareFrame())
-		movie->postHandleFrame();
+	movie->prepareFrame();
 }
 
-bool MoviePlayer::prepareFrame() {
-	if (!_videoLooping && _videoDecoder->endOfVideo()) {
-		_videoFinished = true;
+void MoviePlayer::decodeCallback(void *instance) {
+	MoviePlayer *movie = static_cast<MoviePlayer *>(instance);
+	Common::StackLock lock(movie->_decodeMutex);
+	movie->fillQueue();
+}
+
+void MoviePlayer::fillQueue() {
+	while (true) {
+		QueuedFrame *frame;
+		{
+			Common::StackLock lock(_frameMutex);
+			if (_videoPause || _videoFinished || _decodeFinished || _queueCount == kFrameQueueSize)
+				return;
+			frame = &_frameQueue[(_queueHead + _queueCount) % kFrameQueueSize];
+		}
+
+		// The free slots of the queue are only touched here, so the
+		// frame can be decoded without holding _frameMutex
+		bool decoded = decodeFrame(*frame);
+
+		Common::StackLock lock(_frameMutex);
+		if (!decoded) {
+			_decodeFinished = true;
+			return;
+		}
+		_queueCount++;
 	}
+}
 
+void MoviePlayer::clearQueue() {
+	_queueHead = 0;
+	_queueCount = 0;
+	_decodeFinished = false;
+}
+
+// Copy a frame, reusing the pixels of the destination when possible
+static void copyFrame(Graphics::Surface &dst, const Graphics::Surface &src) {
+	if (dst.pixels && dst.w == src.w && dst.h == src.h && dst.format == src.format && dst.pitch == src.pitch)
+		memcpy(dst.pixels, src.pixels, src.h * src.pitch);
+	else
+		dst.copyFrom(src);
+}
+
+bool MoviePlayer::decodeFrame(QueuedFrame &frame) {
+	if (!_videoLooping && _videoDecoder->endOfVideo())
+		return false;
+
+	handleFrame();
+
+	const uint32 wait = _videoDecoder->getTimeToNextFrame();
+	frame.dueTime = g_system->getMillis() + wait;
+	frame.movieTime = _videoDecoder->getTime() + wait;
+
+	const Graphics::Surface *surface = _videoDecoder->decodeNextFrame();
+	if (!surface)
+		return false;
+	copyFrame(frame.surface, *surface);
+
+	frame.frame = _videoDecoder->getCurFrame();
+	frame.x = _x;
+	frame.y = _y;
+	postHandleFrame(frame);
+
+	return true;
+}
+
+bool MoviePlayer::prepareFrame() {
 	if (_videoPause)
 		return false;
 
+	if (!_videoFinished && _decodeFinished && _queueCount == 0)
+		_videoFinished = true;
+
 	if (_videoFinished) {
 		if (g_grim->getMode() == GrimEngine::SmushMode) {
 			g_grim->setMode(GrimEngine::NormalMode);
@@ -97,16 +183,34 @@ bool MoviePlayer::prepareFrame() {
 		return false;
 	}
 
-	if (_videoDecoder->getTimeToNextFrame() > 0)
+	const uint32 now = g_system->getMillis();
+	if (_queueCount == 0 || (int32)(_frameQueue[_queueHead].dueTime - now) > 0)
 		return false;
 
-	handleFrame();
+	// Skip the frames which are already followed by another due one
+	while (_queueCount > 1 && (int32)(_frameQueue[(_queueHead + 1) % kFrameQueueSize].dueTime - now) <= 0) {
+		_queueHead = (_queueHead + 1) % kFrameQueueSize;
+		_queueCount--;
+		_droppedFrames++;
+	}
+
+	QueuedFrame &frame = _frameQueue[_queueHead];
+	if (now - frame.dueTime > kLateFrameTime)
+		_lateFrames++;
 
-	_internalSurface = _videoDecoder->decodeNextFrame();
+	// Take the pixels of the frame, leaving the ones shown so far for the
+	// decoder to reuse
+	SWAP(frame.surface, _presentedSurface);
+	_internalSurface = &_presentedSurface;
 	_updateNeeded = true;
 
-	_movieTime = _videoDecoder->getTime();
-	_frame = _videoDecoder->getCurFrame();
+	_movieTime = frame.movieTime;
+	_frame = frame.frame;
+	_x = frame.x;
+	_y = frame.y;
+
+	_queueHead = (_queueHead + 1) % kFrameQueueSize;
+	_queueCount--;
 
 	return true;
 }
@@ -123,6 +227,7 @@ Graphics::Surface *MoviePlayer::getDstSurface() {
 void MoviePlayer::init() {
 	if (!_timerStarted) {
 		g_system->getTimerManager()->installTimerProc(&timerCallback, 10000, this, "movieLoop");
+		g_system->getTimerManager()->installTimerProc(&decodeCallback, 10000, this, "movieDecode");
 		_timerStarted = true;
 	}
 
@@ -130,10 +235,13 @@ void MoviePlayer::init() {
 	_movieTime = 0;
 	_updateNeeded = false;
 	_videoFinished = false;
+	_droppedFrames = 0;
+	_lateFrames = 0;
+	clearQueue();
 }
 
 void MoviePlayer::deinit() {
-	Debug::debug(Debug::Movie, "Deinitting video '%s'.\n", _fname.c_str());
+	Debug::debug(Debug::Movie, "Deinitting video '%s', %d frames dropped, %d late.\n", _fname.c_str(), _droppedFrames, _lateFrames);
 
 	if (_videoDecoder)
 		_videoDecoder->close();
@@ -143,11 +251,17 @@ void MoviePlayer::deinit() {
 	if (_externalSurface)
 		_externalSurface->free();
 
+	clearQueue();
+	for (int i = 0; i < kFrameQueueSize; ++i)
+		_frameQueue[i].surface.free();
+	_presentedSurface.free();
+
 	_videoPause = false;
 	_videoFinished = true;
 }
 
 bool MoviePlayer::play(Common::String filename, bool looping, int x, int y) {
+	Common::StackLock decodeLock(_decodeMutex);
 	Common::StackLock lock(_frameMutex);
 	deinit();
 	_x = x;
@@ -164,6 +278,7 @@ bool MoviePlayer::play(Common::String filename, bool looping, int x, int y) {
 	_internalSurface = NULL;
 
 	// Get the first frame immediately
+	fillQueue();
 	timerCallback(this);
 
 	return true;
@@ -235,6 +350,7 @@ private:
 	static void timerCallback(void *ptr) {}
 	void handleFrame() {}
 	bool prepareFrame() { return false; }
+	bool decodeFrame(QueuedFrame &frame) { return false; }
 	void init() {}
 	void deinit() {}
 };
@@ -26,15 +26,45 @@
 #include "common/mutex.h"
 #include "common/system.h"
 
+#include "graphics/surface.h"
+
 #include "video/video_decoder.h"
 
 namespace Grim {
 
 class SaveGame;
 
+/**
+ * Base class of the movie players.
+ *
+ * The frames are decoded ahead of time by a timer of their own, into a
+ * small queue, and a second timer presents them when they are due. This
+ * way the time taken by the decoder doesn't delay the presentation, as
+ * long as the decoder keeps up on average. When the presentation falls
+ * behind, the frames it is too late for are dropped.
+ *
+ * The decoder is protected by _decodeMutex, the queue and everything the
+ * engine reads by _frameMutex. When both are needed, _decodeMutex must be
+ * locked first.
+ */
 class MoviePlayer {
 protected:
+	enum {
+		kFrameQueueSize = 4,
+		/** Frames shown later than this after they were due count as late, in milliseconds */
+		kLateFrameTime = 20
+	};
+
+	struct QueuedFrame {
+		Graphics::Surface surface;
+		uint32 dueTime;		//< g_system->getMillis() at which to show the frame
+		uint32 movieTime;	//< Time of the frame in the movie, in milliseconds
+		int32 frame;
+		int x, y;
+	};
+
 	Common::String _fname;
+	Common::Mutex _decodeMutex;
 	Common::Mutex _frameMutex;
 	Video::VideoDecoder *_videoDecoder;		//< Initialize this to your needed subclass of VideoDecoder in the constructor
 	const Graphics::Surface *_internalSurface;
@@ -50,6 +80,14 @@ protected:
 	bool _timerStarted;
 	int _x, _y;
 
+	QueuedFrame _frameQueue[kFrameQueueSize];
+	int _queueHead, _queueCount;
+	bool _decodeFinished;
+	Graphics::Surface _presentedSurface;
+	uint32 _pauseTime;
+	uint32 _droppedFrames;
+	uint32 _lateFrames;
+
 public:
 	MoviePlayer();
 	virtual ~MoviePlayer();
@@ -77,6 +115,10 @@ public:
 	virtual int getFrame() { return _frame; }
 	virtual void clearUpdateNeeded() { _updateNeeded = false; }
 	virtual int32 getMovieTime() { return (int32)_movieTime; }
+	/** Number of decoded frames which were skipped because a later one was due too. */
+	uint32 getDroppedFrames() const { return _droppedFrames; }
+	/** Number of frames shown more than kLateFrameTime after they were due. */
+	uint32 getLateFrames() const { return _lateFrames; }
 
 	/**
 	 * Saves the state of the video to a savegame
@@ -91,38 +133,56 @@ public:
 
 protected:
 	static void timerCallback(void *ptr);
+	static void decodeCallback(void *ptr);
+
 	/**
-	 * Handles basic stuff per frame, like copying the latest frame to
-	 * _externalBuffer, and updating the frame-counters.
+	 * Handles basic stuff per frame, like taking the frame due from the
+	 * queue, and updating the frame-counters. Needs _frameMutex.
 	 *
-	 * @return false if a frame wasnt drawn to _externalBuffer, true otherwise.
-	 * @see handleFrame
+	 * @return false if no new frame is to be shown, true otherwise.
 	 */
 	virtual bool prepareFrame();
 
+	/**
+	 * Decode frames until the queue is full. Needs _decodeMutex.
+	 */
+	void fillQueue();
+
+	/**
+	 * Drop the queued frames, e.g. after seeking. Needs _frameMutex.
+	 */
+	void clearQueue();
+
+	/**
+	 * Decode the next frame into 'frame', and set when it must be shown.
+	 * Called without _frameMutex, so that the presentation goes on meanwhile.
+	 *
+	 * @return false if there is no frame to decode anymore.
+	 * @see handleFrame
+	 * @see postHandleFrame
+	 */
+	virtual bool decodeFrame(QueuedFrame &frame);
+
 	/**
 	 * Frame-handling function.
 	 *
 	 * Perform any codec-specific per-frame operations before the decoder
 	 * decodes the next frame.
 	 *
-	 * @see prepareFrame
-	 * @see clearUpdateNeeded
-	 * @see isUpdateNeeded
+	 * @see decodeFrame
 	 */
 	virtual void handleFrame() {};
 
 	/**
 	 * Frame-handling function.
 	 *
-	 * Perform any codec-specific per-frame operations after prepareFrame has been
-	 * run, this function is called whenever prepareFrame returns true.
+	 * Perform any codec-specific per-frame operations after the decoder
+	 * decoded a frame, like setting the position to draw it at.
 	 *
-	 * @see prepareFrame
-	 * @see clearUpdateNeeded
-	 * @see isUpdateNeeded
+	 * @param frame			the frame just decoded
+	 * @see decodeFrame
 	 */
-	virtual void postHandleFrame() {};
+	virtual void postHandleFrame(QueuedFrame &frame) {};
 
 	/**
 	 * Initialization of buffers
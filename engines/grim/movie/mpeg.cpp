@@ -65,22 +65,23 @@ protected:
 MpegPlayer::MpegPlayer() : MoviePlayer() {
 	g_movie = this;
 	_speed = 50;
+	_decodingFrame = NULL;
+	_decodedFrames = 0;
+	_startTime = 0;
 	_videoBase = new MpegHandler(this, g_system, MWIDTH, MHEIGHT);
 }
 
 void MpegPlayer::init() {
 	MoviePlayer::init();
+	_decodedFrames = 0;
 
 	// FIXME, deal with pixelformat differently when we get this properly tested.
 	Graphics::PixelFormat format = Graphics::PixelFormat(16, 5, 6, 5, 0, 11, 5, 0, 0);
 	_externalSurface->create(MWIDTH, MHEIGHT, format);
-
-	g_system->getTimerManager()->installTimerProc(&timerCallback, _speed, this, "mpeg loop");
+	_decodingFrame = NULL;
 }
 
 void MpegPlayer::deinit() {
-	g_system->getTimerManager()->removeTimerProc(&timerCallback);
-
 	if (_stream) {
 		_stream->finish();
 		_stream = NULL;
@@ -88,25 +89,44 @@ void MpegPlayer::deinit() {
 	}
 	_videoLooping = false;
 	_videoPause = true;
+	MoviePlayer::deinit();
 }
 
-void MpegPlayer::handleFrame() {
-	if (_videoPause)
-		return;
+void MpegPlayer::pause(bool p) {
+	Common::StackLock decodeLock(_decodeMutex);
 
-	if (!_videoBase->decodeFrame()) {
-		_videoFinished = true;
-		g_grim->setMode(GrimEngine::NormalMode);
-		return;
-	}
-	//else
-	//bas->updateScreen();
+	// The frames still to be decoded are due that much later, too
+	if (!p && _videoPause)
+		_startTime += g_system->getMillis() - _pauseTime;
+	MoviePlayer::pause(p);
+}
+
+bool MpegPlayer::decodeFrame(QueuedFrame &frame) {
+	if (!frame.surface.pixels)
+		frame.surface.create(MWIDTH, MHEIGHT, _externalSurface->format);
+	_decodingFrame = &frame;
+	bool decoded = _videoBase->decodeFrame();
+	_decodingFrame = NULL;
+	if (!decoded)
+		return false;
+
+	// The frames are due one frame period after the other from the first
+	// one on. Without a period, which shouldn't happen once a frame was
+	// decoded, show them as they come.
+	const uint32 period = _videoBase->getFramePeriod();
+	if (_decodedFrames == 0 || period == 0)
+		_startTime = g_system->getMillis();
+	frame.movieTime = (uint32)((uint64)_decodedFrames * period / 1000);
+	frame.dueTime = _startTime + frame.movieTime;
+	frame.frame = ++_decodedFrames;
+	frame.x = _x;
+	frame.y = _y;
+	return true;
 }
 
 void MpegPlayer::deliverFrameFromDecode(int width, int height, uint16 *dat) {
-	memcpy(_externalSurface->pixels, dat, _externalSurface->w * _externalSurface->h * 2);
-	_frame++;
-	_updateNeeded = true;
+	if (_decodingFrame)
+		memcpy(_decodingFrame->surface.pixels, dat, MWIDTH * MHEIGHT * 2);
 }
 
 bool MpegPlayer::loadFile(Common::String filename) {
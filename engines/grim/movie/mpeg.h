@@ -45,12 +45,17 @@ private:
 	Audio::SoundHandle _soundHandle;
 	Audio::QueuingAudioStream *_stream;
 	int _speed;	// <- Quickfix to fix compile, verify when fixing the decoder properly.
+	QueuedFrame *_decodingFrame;
+	int32 _decodedFrames;
+	uint32 _startTime;	//< g_system->getMillis() at which the first frame is due
 public:
 	MpegPlayer();
 
+	void pause(bool p);
+
 	void deliverFrameFromDecode(int width, int height, uint16 *dat);
 private:
-	void handleFrame();
+	bool decodeFrame(QueuedFrame &frame);
 	void init();
 	void deinit();
 	bool loadFile(Common::String filename);
@@ -56,31 +56,21 @@ void SmushPlayer::init() {
 	MoviePlayer::init();
 }
 
-void SmushPlayer::handleFrame() {
-	if (_videoDecoder->endOfVideo()) {
-		// If we're not supposed to loop (or looping fails) then end the video
-		if (!_videoLooping ) {
-			_videoFinished = true;
-			g_grim->setMode(GrimEngine::NormalMode);
-			deinit();
-			return;
-		} else {
-// 			getDecoder()->rewind(); // This doesnt handle if looping fails.
-		}
-	}
-}
-
-void SmushPlayer::postHandleFrame() {
+void SmushPlayer::postHandleFrame(QueuedFrame &frame) {
 	if (_demo) {
-		_x = _smushDecoder->getX();
-		_y = _smushDecoder->getY();
+		frame.x = _smushDecoder->getX();
+		frame.y = _smushDecoder->getY();
 	}
 }
 
 void SmushPlayer::restoreState(SaveGame *state) {
 	MoviePlayer::restoreState(state);
 	if (isPlaying()) {
-		_smushDecoder->seekToTime((uint32)_movieTime); // Currently not fully working (out of synch)
+		Common::StackLock decodeLock(_decodeMutex);
+		Common::StackLock lock(_frameMutex);
+		// The frames decoded by play() are from the start of the video
+		clearQueue();
+		_smushDecoder->seekToTime((uint32)_movieTime);
 	}
 }
 
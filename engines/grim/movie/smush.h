@@ -36,8 +36,7 @@ public:
 	void restoreState(SaveGame *state);
 private:
 	bool loadFile(Common::String filename);
-	void handleFrame();
-	void postHandleFrame();
+	void postHandleFrame(QueuedFrame &frame);
 	void init();
 	bool _demo;
 	SmushDecoder *_smushDecoder;
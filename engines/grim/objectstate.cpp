@@ -28,7 +28,7 @@
 namespace Grim {
 
 ObjectState::ObjectState(int setup, ObjectState::Position position, const char *bitmap, const char *zbitmap, bool transparency) :
-		_setupID(setup), _pos(position), _visibility(false) {
+		_setupID(setup), _pos(position), _visibility(false), _saveGeneration(1) {
 
 	_bitmap = Bitmap::create(bitmap);
 	if (zbitmap) {
@@ -38,7 +38,7 @@ ObjectState::ObjectState(int setup, ObjectState::Position position, const char *
 }
 
 ObjectState::ObjectState() :
-		_bitmap(NULL), _zbitmap(NULL) {
+		_bitmap(NULL), _zbitmap(NULL), _saveGeneration(1) {
 
 }
 
@@ -60,7 +60,10 @@ void ObjectState::setActiveImage(int val) {
 		}
 	}
 
-	_visibility = val != 0;
+	if (_visibility != (val != 0)) {
+		_visibility = val != 0;
+		++_saveGeneration;
+	}
 }
 
 void ObjectState::draw() {
@@ -100,6 +103,7 @@ bool ObjectState::restoreState(SaveGame *savedState) {
 
 	_bitmap = Bitmap::getPool().getObject(savedState->readLESint32());
 	_zbitmap = Bitmap::getPool().getObject(savedState->readLESint32());
+	++_saveGeneration;
 
 	return true;
 }
@@ -49,10 +49,11 @@ public:
 
 	void saveState(SaveGame *savedState) const;
 	bool restoreState(SaveGame *savedState);
+	uint32 getSaveGeneration() const { return _saveGeneration; }
 
 	int getSetupID() const { return _setupID; }
 	Position getPos() const { return _pos; }
-	void setPos(Position position) { _pos = position; }
+	void setPos(Position position) { _pos = position; ++_saveGeneration; }
 
 	const Common::String &getBitmapFilename() const;
 
@@ -64,6 +65,7 @@ private:
 	int _setupID;
 	Position _pos;
 	Bitmap::Ptr _bitmap, _zbitmap;
+	uint32 _saveGeneration;
 };
 
 } // end of namespace Grim
@@ -90,6 +90,8 @@ public:
 		void restoreObjects(SaveGame *save);
 
 	private:
+		bool getSaveGenerations(Common::Array<uint32> &generations);
+
 		bool _restoring;
 		Common::HashMap<int32, T*> _map;
 	};
@@ -141,6 +143,15 @@ public:
 	int getId() const;
 	virtual int32 getTag() const { return T::getStaticTag(); }
 
+	/**
+	 * Return a value which changes every time the saved state of this object
+	 * changes, so that snapshot savegames can skip the serialization of pools
+	 * whose objects didn't change.
+	 * 0 means that the object doesn't keep track of its changes, so its pool
+	 * is always serialized. Only Bitmap, Font and ObjectState track them.
+	 */
+	uint32 getSaveGeneration() const { return 0; }
+
 	static Pool &getPool();
 
 protected:
@@ -285,8 +296,27 @@ void PoolObject<T>::Pool::deleteObjects() {
 	delete this;
 }
 
+template <class T>
+bool PoolObject<T>::Pool::getSaveGenerations(Common::Array<uint32> &generations) {
+	generations.reserve(_map.size() * 2);
+	for (iterator i = begin(); i != end(); ++i) {
+		uint32 generation = (*i)->getSaveGeneration();
+		if (generation == 0)
+			return false;
+		generations.push_back(i.getId());
+		generations.push_back(generation);
+	}
+	return true;
+}
+
 template <class T>
 void PoolObject<T>::Pool::saveObjects(SaveGame *state) {
+	if (state->isSnapshot()) {
+		Common::Array<uint32> generations;
+		if (getSaveGenerations(generations) && state->reuseSection(T::getStaticTag(), generations))
+			return;
+	}
+
 	state->beginSection(T::getStaticTag());
 
 	T::saveStaticState(state);
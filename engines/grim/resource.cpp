@@ -522,6 +522,16 @@ void ResourceLoader::uncacheModel(Model *m) {
 	_models.remove(m);
 }
 
+void ResourceLoader::uncacheModel(EMIModel *m) {
+	_emiModels.remove(m);
+}
+
+void ResourceLoader::rebindSpecialtyTextures() {
+	for (Common::List<EMIModel *>::const_iterator i = _emiModels.begin(); i != _emiModels.end(); ++i) {
+		(*i)->bindSpecialtyTextures();
+	}
+}
+
 void ResourceLoader::uncacheColormap(CMap *c) {
 	_colormaps.remove(c);
 }
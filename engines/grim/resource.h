@@ -75,9 +75,15 @@ public:
 	KeyframeAnimPtr getKeyframe(const Common::String &fname);
 	LipSyncPtr getLipSync(const Common::String &fname);
 	void uncacheModel(Model *m);
+	void uncacheModel(EMIModel *m);
 	void uncacheColormap(CMap *c);
 	void uncacheKeyframe(KeyframeAnim *kf);
 	void uncacheLipSync(LipSync *l);
+	/**
+	 * Point the specialty materials of the loaded EMI models at the ones of
+	 * the current renderer, after it was replaced.
+	 */
+	void rebindSpecialtyTextures();
 
 	struct ResourceCache {
 		char *fname;
@@ -21,7 +21,10 @@
  */
 
 #include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #include "math/vector3d.h"
 
@@ -36,7 +39,171 @@ namespace Grim {
 uint SaveGame::SAVEGAME_MAJOR_VERSION = 22;
 uint SaveGame::SAVEGAME_MINOR_VERSION = 3;
 
+/**
+ * Writes the sections of a snapshot savegame to the save file from a timer
+ * callback, a bounded amount of data per call, so that the compression of the
+ * save file doesn't stall the main loop.
+ */
+class SaveGameWriter {
+public:
+	SaveGameWriter(Common::OutSaveFile *file, const Common::Array<SaveGame::SectionPtr> &sections);
+	~SaveGameWriter();
+
+	bool isDone();
+	void finish();
+
+private:
+	void writeChunk(uint32 budget);
+
+	static void timerCallback(void *refCon);
+
+	static const uint32 _chunkSize = 65536;
+
+	Common::Mutex _mutex;
+	Common::OutSaveFile *_file;
+	Common::Array<SaveGame::SectionPtr> _sections;
+	uint _currentSection;
+	uint32 _sectionPos;
+	bool _done;
+};
+
+struct CachedSection {
+	Common::Array<uint32> _generations;
+	SaveGame::SectionPtr _section;
+};
+
+typedef Common::HashMap<uint32, CachedSection> SectionCache;
+
+static SaveGameWriter *s_writer = NULL;
+static SectionCache *s_sectionCache = NULL;
+static Common::Array<SaveGame::Section *> *s_freeSections = NULL;
+
+// Maximum number of section buffers kept around for the next snapshot.
+static const uint kMaxFreeSections = 32;
+
+SaveGameWriter::SaveGameWriter(Common::OutSaveFile *file, const Common::Array<SaveGame::SectionPtr> &sections) :
+	_file(file), _sections(sections), _currentSection(0), _sectionPos(0), _done(false) {
+
+	g_system->getTimerManager()->installTimerProc(&timerCallback, 10000, this, "grimSaveWriter");
+}
+
+SaveGameWriter::~SaveGameWriter() {
+	g_system->getTimerManager()->removeTimerProc(&timerCallback);
+	finish();
+}
+
+bool SaveGameWriter::isDone() {
+	Common::StackLock lock(_mutex);
+	return _done;
+}
+
+void SaveGameWriter::finish() {
+	Common::StackLock lock(_mutex);
+	while (!_done)
+		writeChunk(0xFFFFFFFF);
+}
+
+void SaveGameWriter::writeChunk(uint32 budget) {
+	while (budget > 0 && _currentSection < _sections.size()) {
+		const SaveGame::Section *section = _sections[_currentSection].get();
+		if (_sectionPos == 0) {
+			_file->writeUint32BE(section->_tag);
+			_file->writeUint32BE(section->_size);
+		}
+
+		uint32 size = MIN(budget, section->_size - _sectionPos);
+		_file->write(section->_data + _sectionPos, size);
+		_sectionPos += size;
+		budget -= size;
+
+		if (_sectionPos == section->_size) {
+			++_currentSection;
+			_sectionPos = 0;
+		}
+	}
+
+	if (_currentSection == _sections.size()) {
+		_file->writeUint32BE(SAVEGAME_FOOTERTAG);
+		_file->finalize();
+		if (_file->err())
+			warning("SaveGameWriter: Can't write file. (Disk full?)");
+		delete _file;
+		_file = NULL;
+		_done = true;
+	}
+}
+
+void SaveGameWriter::timerCallback(void *refCon) {
+	SaveGameWriter *writer = static_cast<SaveGameWriter *>(refCon);
+	Common::StackLock lock(writer->_mutex);
+	if (!writer->_done)
+		writer->writeChunk(_chunkSize);
+}
+
+void SaveGame::finishPendingWrites() {
+	if (s_writer) {
+		s_writer->finish();
+		delete s_writer;
+		s_writer = NULL;
+	}
+}
+
+void SaveGame::pollPendingWrites() {
+	if (s_writer && s_writer->isDone()) {
+		delete s_writer;
+		s_writer = NULL;
+	}
+}
+
+void SaveGame::purgeCaches() {
+	finishPendingWrites();
+
+	delete s_sectionCache;
+	s_sectionCache = NULL;
+
+	if (s_freeSections) {
+		for (uint i = 0; i < s_freeSections->size(); ++i) {
+			free((*s_freeSections)[i]->_data);
+			delete (*s_freeSections)[i];
+		}
+		delete s_freeSections;
+		s_freeSections = NULL;
+	}
+}
+
+byte *SaveGame::allocSectionBuffer(uint32 &alloc) {
+	if (s_freeSections && !s_freeSections->empty()) {
+		Section *section = s_freeSections->back();
+		s_freeSections->pop_back();
+		byte *data = section->_data;
+		alloc = section->_alloc;
+		delete section;
+		return data;
+	}
+
+	alloc = _allocAmmount;
+	return (byte *)malloc(alloc);
+}
+
+void SaveGame::releaseSection(Section *section) {
+	if (!s_freeSections)
+		s_freeSections = new Common::Array<Section *>();
+
+	if (s_freeSections->size() < kMaxFreeSections) {
+		s_freeSections->push_back(section);
+	} else {
+		free(section->_data);
+		delete section;
+	}
+}
+
 SaveGame *SaveGame::openForLoading(const Common::String &filename) {
+	// The file may be the one still being written in background. Any section
+	// cached from the previous snapshot is also out of date once we load.
+	finishPendingWrites();
+	delete s_sectionCache;
+	s_sectionCache = NULL;
+
 	Common::InSaveFile *inSaveFile = g_system->getSavefileManager()->openForLoading(filename);
 	if (!inSaveFile) {
 		warning("SaveGame::openForLoading() Error opening savegame file %s", filename.c_str());
@@ -59,7 +226,9 @@ SaveGame *SaveGame::openForLoading(const Common::String &filename) {
 	return save;
 }
 
-SaveGame *SaveGame::openForSaving(const Common::String &filename) {
+SaveGame *SaveGame::openForSaving(const Common::String &filename, bool snapshot) {
+	finishPendingWrites();
+
 	Common::OutSaveFile *outSaveFile =  g_system->getSavefileManager()->openForSaving(filename);
 	if (!outSaveFile) {
 		warning("SaveGame::openForSaving() Error creating savegame file %s", filename.c_str());
@@ -69,6 +238,7 @@ SaveGame *SaveGame::openForSaving(const Common::String &filename) {
 	SaveGame *save = new SaveGame();
 
 	save->_saving = true;
+	save->_snapshot = snapshot;
 	save->_outSaveFile = outSaveFile;
 
 	outSaveFile->writeUint32BE(SAVEGAME_HEADERTAG);
@@ -82,12 +252,18 @@ SaveGame *SaveGame::openForSaving(const Common::String &filename) {
 }
 
 SaveGame::SaveGame() :
-	_currentSection(0), _sectionBuffer(0) {
+	_currentSection(0), _sectionBuffer(0), _snapshot(false), _cachedTag(0) {
 
 }
 
 SaveGame::~SaveGame() {
-	if (_saving) {
+	if (_snapshot) {
+		// Hand the file over to the background writer, which will also release
+		// the sections once done.
+		finishPendingWrites();
+		s_writer = new SaveGameWriter(_outSaveFile, _sections);
+		_sections.clear();
+	} else if (_saving) {
 		_outSaveFile->writeUint32BE(SAVEGAME_FOOTERTAG);
 		_outSaveFile->finalize();
 		if (_outSaveFile->err())
@@ -138,8 +314,12 @@ uint32 SaveGame::beginSection(uint32 sectionTag) {
 
 	} else {
 		if (!_sectionBuffer) {
-			_sectionAlloc = _allocAmmount;
-			_sectionBuffer = (byte *)malloc(_sectionAlloc);
+			if (_snapshot) {
+				_sectionBuffer = allocSectionBuffer(_sectionAlloc);
+			} else {
+				_sectionAlloc = _allocAmmount;
+				_sectionBuffer = (byte *)malloc(_sectionAlloc);
+			}
 		}
 	}
 	_sectionPtr = 0;
@@ -149,7 +329,26 @@ uint32 SaveGame::beginSection(uint32 sectionTag) {
 void SaveGame::endSection() {
 	if (_currentSection == 0)
 		error("Tried to end a save game section without starting a section");
-	if (_saving) {
+	if (_snapshot) {
+		Section *section = new Section();
+		section->_tag = _currentSection;
+		section->_size = _sectionSize;
+		section->_alloc = _sectionAlloc;
+		section->_data = _sectionBuffer;
+		_sectionBuffer = NULL;
+
+		SectionPtr ptr(section, &releaseSection);
+		_sections.push_back(ptr);
+
+		if (_cachedTag == _currentSection) {
+			if (!s_sectionCache)
+				s_sectionCache = new SectionCache();
+			CachedSection &cached = (*s_sectionCache)[_currentSection];
+			cached._generations = _cachedGenerations;
+			cached._section = ptr;
+			_cachedTag = 0;
+		}
+	} else if (_saving) {
 		_outSaveFile->writeUint32BE(_currentSection);
 		_outSaveFile->writeUint32BE(_sectionSize);
 		_outSaveFile->write(_sectionBuffer, _sectionSize);
@@ -157,6 +356,23 @@ void SaveGame::endSection() {
 	_currentSection = 0;
 }
 
+bool SaveGame::reuseSection(uint32 sectionTag, const Common::Array<uint32> &generations) {
+	if (!_snapshot)
+		return false;
+
+	if (s_sectionCache && s_sectionCache->contains(sectionTag)) {
+		const CachedSection &cached = s_sectionCache->getVal(sectionTag);
+		if (cached._generations == generations) {
+			_sections.push_back(cached._section);
+			return true;
+		}
+	}
+
+	_cachedTag = sectionTag;
+	_cachedGenerations = generations;
+	return false;
+}
+
 uint32 SaveGame::getBufferPos() {
 	if (_saving)
 		return _sectionSize;
@@ -24,6 +24,8 @@
 #define GRIM_SAVEGAME_H
 
 #include "common/savefile.h"
+#include "common/array.h"
+#include "common/ptr.h"
 
 #include "math/mathfwd.h"
 
@@ -34,9 +36,36 @@ class Color;
 class SaveGame {
 public:
 	static SaveGame *openForLoading(const Common::String &filename);
-	static SaveGame *openForSaving(const Common::String &filename);
+	/**
+	 * Open a savegame for writing.
+	 *
+	 * @param filename	the name of the save file.
+	 * @param snapshot	if true, the sections are only copied in memory while the
+	 *			game state is serialized; compressing and writing them to
+	 *			the file is then left to a background timer. The sections
+	 *			of the pools whose objects keep a save generation (bitmaps,
+	 *			fonts and object states) are reused from the previous
+	 *			snapshot when unchanged, see reuseSection(). All the other
+	 *			sections, and the Lua state, are serialized every time.
+	 */
+	static SaveGame *openForSaving(const Common::String &filename, bool snapshot = false);
 	~SaveGame();
 
+	/**
+	 * Complete synchronously the writing of the last snapshot savegame, if
+	 * it is still in progress.
+	 */
+	static void finishPendingWrites();
+	/**
+	 * Release the resources of the last snapshot savegame if the background
+	 * writer is done with it. Meant to be called once per frame.
+	 */
+	static void pollPendingWrites();
+	/**
+	 * Free the section buffers and the sections cached for the next snapshot.
+	 */
+	static void purgeCaches();
+
 	/**
 	 * Major savegame version.
 	 * If a savegame has a different major version than SAVEGAME_MAJOR_VERSION
@@ -82,9 +111,35 @@ public:
 
 	void checkAlloc(int size);
 
+	bool isSnapshot() const { return _snapshot; }
+	/**
+	 * When saving a snapshot, reuse the section written by the previous snapshot
+	 * if it was tagged with the same generations.
+	 * If true is returned the section has been queued again and must not be
+	 * written. Otherwise the next section with the given tag which is written will
+	 * be remembered with these generations.
+	 *
+	 * @param sectionTag	the tag of the section.
+	 * @param generations	a list of values which changes whenever the content of
+	 *			the section changes, e.g. the ids and save generations
+	 *			of the objects of a pool.
+	 */
+	bool reuseSection(uint32 sectionTag, const Common::Array<uint32> &generations);
+
+	struct Section {
+		uint32 _tag;
+		uint32 _size;
+		uint32 _alloc;
+		byte *_data;
+	};
+	typedef Common::SharedPtr<Section> SectionPtr;
+
 protected:
 	SaveGame();
 
+	static byte *allocSectionBuffer(uint32 &alloc);
+	static void releaseSection(Section *section);
+
 	uint _majorVersion;
 	uint _minorVersion;
 	bool _saving;
@@ -96,6 +151,11 @@ protected:
 	uint32 _sectionPtr;
 	byte *_sectionBuffer;
 
+	bool _snapshot;
+	Common::Array<SectionPtr> _sections;
+	uint32 _cachedTag;
+	Common::Array<uint32> _cachedGenerations;
+
 	static const int _allocAmmount = 1048576;
 };
 
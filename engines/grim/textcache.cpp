@@ -0,0 +1,226 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+#include "engines/grim/textcache.h"
+#include "engines/grim/debug.h"
+
+namespace Grim {
+
+TextCache *g_textCache = NULL;
+
+// Change this when the scanning in TextSplitter changes, or when the loaders
+// scan their lines differently, so that the old values are not used.
+static const uint32 kTextCacheVersion = 1;
+
+// The values are stored as they are in memory, so the cache can't be shared
+// between machines of a different byte order.
+static const uint32 kByteOrderMark = 0x01020304;
+
+TextCache::TextCache(const Common::String &filename) :
+		_filename(filename), _fileData(NULL), _totalLength(0), _useCount(0), _dirty(false) {
+	load();
+}
+
+TextCache::~TextCache() {
+	if (_dirty)
+		save();
+
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		freeEntry(i->_value);
+	}
+	delete[] _fileData;
+}
+
+void TextCache::freeEntry(Entry &entry) {
+	if (entry.owned)
+		delete[] entry.data;
+	entry.data = NULL;
+}
+
+uint32 TextCache::hashData(const byte *data, uint32 size) {
+	// FNV-1a
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+const byte *TextCache::find(const Common::String &name, uint32 size, uint32 hash, uint32 *length) {
+	EntryMap::iterator i = _entries.find(name);
+	if (i == _entries.end() || i->_value.size != size || i->_value.hash != hash)
+		return NULL;
+
+	i->_value.lastUse = ++_useCount;
+	*length = i->_value.length;
+	return i->_value.data;
+}
+
+void TextCache::store(const Common::String &name, uint32 size, uint32 hash, const byte *data, uint32 length) {
+	remove(name);
+
+	Entry &entry = _entries[name];
+	byte *copy = new byte[length];
+	memcpy(copy, data, length);
+	entry.size = size;
+	entry.hash = hash;
+	entry.data = copy;
+	entry.length = length;
+	entry.lastUse = ++_useCount;
+	entry.owned = true;
+	_totalLength += length;
+	_dirty = true;
+
+	trim();
+}
+
+void TextCache::remove(const Common::String &name) {
+	EntryMap::iterator i = _entries.find(name);
+	if (i == _entries.end())
+		return;
+
+	_totalLength -= i->_value.length;
+	freeEntry(i->_value);
+	_entries.erase(i);
+	_dirty = true;
+}
+
+void TextCache::trim() {
+	// Evictions are rare, so the oldest entry is just searched for each time
+	while (_totalLength > kMaxBytes && _entries.size() > 1) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+		Debug::debug(Debug::Engine, "TextCache: Dropping %s", oldest->_key.c_str());
+		remove(oldest->_key);
+	}
+}
+
+void TextCache::load() {
+	Common::InSaveFile *file = g_system->getSavefileManager()->openForLoading(_filename);
+	if (!file)
+		return;
+
+	uint32 fileSize = file->size();
+	uint32 byteOrder = 0;
+	if (fileSize < 16 || file->readUint32BE() != MKTAG('G','T','X','C') ||
+			file->readUint32LE() != kTextCacheVersion || file->read(&byteOrder, 4) != 4 ||
+			byteOrder != kByteOrderMark) {
+		Debug::debug(Debug::Engine, "TextCache: Discarding %s", _filename.c_str());
+		delete file;
+		return;
+	}
+
+	// The entries point into the data of the file, which is read at once.
+	uint32 dataSize = fileSize - file->pos();
+	_fileData = new byte[dataSize];
+	if (file->read(_fileData, dataSize) != dataSize) {
+		warning("TextCache: Could not read %s", _filename.c_str());
+		delete file;
+		return;
+	}
+	delete file;
+
+	const byte *ptr = _fileData;
+	const byte *end = _fileData + dataSize;
+	uint32 numEntries = READ_LE_UINT32(ptr);
+	ptr += 4;
+	for (uint32 i = 0; i < numEntries; ++i) {
+		if (end - ptr < 2)
+			break;
+		uint32 nameLength = READ_LE_UINT16(ptr);
+		ptr += 2;
+		if ((uint32)(end - ptr) < nameLength + 12)
+			break;
+		Common::String name((const char *)ptr, nameLength);
+		ptr += nameLength;
+
+		Entry entry;
+		entry.size = READ_LE_UINT32(ptr);
+		entry.hash = READ_LE_UINT32(ptr + 4);
+		entry.length = READ_LE_UINT32(ptr + 8);
+		entry.data = ptr + 12;
+		entry.owned = false;
+		ptr += 12;
+		if ((uint32)(end - ptr) < entry.length)
+			break;
+		ptr += entry.length;
+
+		// The entries are saved from the least to the most recently used
+		entry.lastUse = ++_useCount;
+		remove(name);
+		_entries[name] = entry;
+		_totalLength += entry.length;
+	}
+	_dirty = false;
+	trim();
+
+	Debug::debug(Debug::Engine, "TextCache: Loaded %d entries from %s", _entries.size(), _filename.c_str());
+}
+
+bool TextCache::lessRecentlyUsed(EntryMap::const_iterator a, EntryMap::const_iterator b) {
+	return a->_value.lastUse < b->_value.lastUse;
+}
+
+void TextCache::save() {
+	Common::OutSaveFile *file = g_system->getSavefileManager()->openForSaving(_filename, false);
+	if (!file) {
+		warning("TextCache: Could not write %s", _filename.c_str());
+		return;
+	}
+
+	uint32 byteOrder = kByteOrderMark;
+	file->writeUint32BE(MKTAG('G','T','X','C'));
+	file->writeUint32LE(kTextCacheVersion);
+	file->write(&byteOrder, 4);
+	Common::Array<EntryMap::const_iterator> order;
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+		order.push_back(i);
+	Common::sort(order.begin(), order.end(), lessRecentlyUsed);
+
+	file->writeUint32LE(order.size());
+	for (uint i = 0; i < order.size(); ++i) {
+		const Common::String &name = order[i]->_key;
+		const Entry &entry = order[i]->_value;
+		file->writeUint16LE(name.size());
+		file->write(name.c_str(), name.size());
+		file->writeUint32LE(entry.size);
+		file->writeUint32LE(entry.hash);
+		file->writeUint32LE(entry.length);
+		file->write(entry.data, entry.length);
+	}
+	file->finalize();
+	if (file->err())
+		warning("TextCache: Could not write %s", _filename.c_str());
+	delete file;
+	_dirty = false;
+}
+
+} // end of namespace Grim
@@ -0,0 +1,104 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRIM_TEXTCACHE_H
+#define GRIM_TEXTCACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+namespace Grim {
+
+/**
+ * Keeps the values TextSplitter scanned from text resources across runs, so
+ * that the lines don't need to be parsed again the next time the same
+ * resource is loaded.
+ *
+ * The entries are keyed by the name of the resource and checked against its
+ * size and a hash of its contents. They are all stored in a single file in
+ * the save directory, which is read at once when the cache is created and
+ * written back when it is destroyed, if anything changed. When the values
+ * grow past kMaxBytes, the least recently used entries are dropped.
+ */
+class TextCache {
+public:
+	enum {
+		kMaxBytes = 4 * 1024 * 1024
+	};
+
+	TextCache(const Common::String &filename);
+	~TextCache();
+
+	/**
+	 * Get the values stored for a resource, or NULL if there are none for
+	 * this exact content. The data stays valid only until the next call to
+	 * store() or remove().
+	 */
+	const byte *find(const Common::String &name, uint32 size, uint32 hash, uint32 *length);
+
+	/**
+	 * Store the values scanned from a resource, replacing older ones.
+	 */
+	void store(const Common::String &name, uint32 size, uint32 hash, const byte *data, uint32 length);
+
+	/**
+	 * Drop the values stored for a resource, e.g. because they turned out
+	 * to be bad.
+	 */
+	void remove(const Common::String &name);
+
+	/**
+	 * A hash of the contents of a resource, to tell whether it changed.
+	 */
+	static uint32 hashData(const byte *data, uint32 size);
+
+private:
+	struct Entry {
+		uint32 size;
+		uint32 hash;
+		const byte *data;
+		uint32 length;
+		uint32 lastUse;
+		bool owned;
+	};
+	typedef Common::HashMap<Common::String, Entry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> EntryMap;
+
+	void load();
+	void save();
+	void freeEntry(Entry &entry);
+	void trim();
+	static bool lessRecentlyUsed(EntryMap::const_iterator a, EntryMap::const_iterator b);
+
+	Common::String _filename;
+	byte *_fileData;
+	EntryMap _entries;
+	uint32 _totalLength;
+	uint32 _useCount;
+	bool _dirty;
+};
+
+extern TextCache *g_textCache;
+
+} // end of namespace Grim
+
+#endif
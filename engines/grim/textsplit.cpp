@@ -25,6 +25,7 @@
 #include "common/stream.h"
 
 #include "engines/grim/textsplit.h"
+#include "engines/grim/textcache.h"
 
 namespace Grim {
 
@@ -94,9 +95,42 @@ static char *parseCharacterClass(const char *code, bool *isNegated) {
 	return chars;
 }
 
+static void appendUint32(Common::Array<byte> &record, uint32 value) {
+	byte buf[4];
+	WRITE_UINT32(buf, value);
+	for (int i = 0; i < 4; ++i)
+		record.push_back(buf[i]);
+}
+
+static void appendUint16(Common::Array<byte> &record, uint16 value) {
+	byte buf[2];
+	WRITE_UINT16(buf, value);
+	record.push_back(buf[0]);
+	record.push_back(buf[1]);
+}
+
+// Fields are recorded as the bytes written to the variable, without the
+// zeros at the end of string buffers.
+static const uint16 kEndOfFields = 0xffff;
+
+static void recordField(Common::Array<byte> *record, const void *var, uint size) {
+	if (!record)
+		return;
+
+	const byte *bytes = (const byte *)var;
+	uint length = size;
+	while (length > 0 && bytes[length - 1] == 0)
+		--length;
+
+	appendUint16(*record, size);
+	appendUint16(*record, length);
+	for (uint i = 0; i < length; ++i)
+		record->push_back(bytes[i]);
+}
+
 // This function is modelled after sscanf, and supports a subset of its features. See sscanf documentation
 // for information about the syntax it accepts.
-static void parse(const char *line, const char *fmt, int field_count, va_list va) {
+static void parse(const char *line, const char *fmt, int field_count, va_list va, Common::Array<byte> *record) {
 	char *str = strdup(line);
 	const int len = strlen(str);
 	for (int i = 0; i < len; ++i) {
@@ -140,6 +174,7 @@ static void parse(const char *line, const char *fmt, int field_count, va_list va
 			void *var = va_arg(va, void *);
 			if (strcmp(code, "n") == 0) {
 				*(int*)var = src - str;
+				recordField(record, var, sizeof(int));
 				continue;
 			}
 
@@ -190,23 +225,31 @@ static void parse(const char *line, const char *fmt, int field_count, va_list va
 
 			if (strcmp(code, "d") == 0) {
 				*(int*)var = atoi(s);
+				recordField(record, var, sizeof(int));
 			} else if (strcmp(code, "x") == 0) {
 				*(int*)var = strtol(s, (char **) NULL, 16);
+				recordField(record, var, sizeof(int));
 			} else if (strcmp(code, "f") == 0) {
 				*(float*)var = str2float(s);
+				recordField(record, var, sizeof(float));
 			} else if (strcmp(code, "c") == 0) {
 				*(char*)var = s[0];
+				recordField(record, var, sizeof(char));
 			} else if (strcmp(code, "s") == 0) {
 				char *string = (char*)var;
 				strncpy(string, s, fieldWidth);
 				if (fieldWidth <= strlen(s)) {
 					// add terminating \0
 					string[fieldWidth] = '\0';
+					recordField(record, var, fieldWidth + 1);
+				} else {
+					recordField(record, var, fieldWidth);
 				}
 			} else if (code[0] == '[') {
 				char *string = (char*)var;
 				strncpy(string, s, fieldWidth);
 				string[fieldWidth-1] = '\0';
+				recordField(record, var, fieldWidth);
 			} else {
 				error("Code not handled: \"%s\" \"%s\"\n\"%s\" \"%s\"", code, s, line, fmt);
 			}
@@ -239,10 +282,23 @@ static void parse(const char *line, const char *fmt, int field_count, va_list va
 	if (count < field_count) {
 		error("Expected line of format '%s', got '%s'", fmt, line);
 	}
+
+	if (record)
+		appendUint16(*record, kEndOfFields);
+}
+
+
+TextSplitter::TextSplitter(Common::SeekableReadStream *data) :
+		_dataSize(0), _dataHash(0), _replayPos(NULL), _replayEnd(NULL), _recording(false) {
+	init(data);
 }
 
+TextSplitter::TextSplitter(const Common::String &fname, Common::SeekableReadStream *data) :
+		_cacheName(fname), _dataSize(0), _dataHash(0), _replayPos(NULL), _replayEnd(NULL), _recording(false) {
+	init(data);
+}
 
-TextSplitter::TextSplitter(Common::SeekableReadStream *data) {
+void TextSplitter::init(Common::SeekableReadStream *data) {
 	char *line;
 	int i;
 	uint32 len = data->size();
@@ -250,6 +306,24 @@ TextSplitter::TextSplitter(Common::SeekableReadStream *data) {
 	_stringData = new char[len + 1];
 	data->read(_stringData, len);
 	_stringData[len] = '\0';
+
+	if (g_textCache && !_cacheName.empty()) {
+		_dataSize = len;
+		_dataHash = TextCache::hashData((const byte *)_stringData, len);
+		uint32 length;
+		const byte *values = g_textCache->find(_cacheName, _dataSize, _dataHash, &length);
+		if (!values) {
+			_recording = true;
+		} else if (length > 0) {
+			// Loading other resources while this one is read may evict the
+			// entry from the cache, so the values are replayed from a copy
+			_record.resize(length);
+			memcpy(&_record[0], values, length);
+			_replayPos = &_record[0];
+			_replayEnd = _replayPos + length;
+		}
+	}
+
 	// Find out how many lines of text there are
 	_numLines = _lineIndex = 0;
 	line = (char *)_stringData;
@@ -275,6 +349,9 @@ TextSplitter::TextSplitter(Common::SeekableReadStream *data) {
 }
 
 TextSplitter::~TextSplitter() {
+	if (_recording && g_textCache) {
+		g_textCache->store(_cacheName, _dataSize, _dataHash, _record.empty() ? NULL : &_record[0], _record.size());
+	}
 	delete[] _stringData;
 	delete[] _lines;
 }
@@ -305,7 +382,7 @@ void TextSplitter::scanString(const char *fmt, int field_count, ...) {
 	va_list va;
 	va_start(va, field_count);
 
-	parse(getCurrentLine(), fmt, field_count, va);
+	scan(0, fmt, field_count, va);
 
 	va_end(va);
 
@@ -319,7 +396,7 @@ void TextSplitter::scanStringAtOffset(int offset, const char *fmt, int field_cou
 	va_list va;
 	va_start(va, field_count);
 
-	parse(getCurrentLine() + offset, fmt, field_count, va);
+	scan(offset, fmt, field_count, va);
 
 	va_end(va);
 
@@ -333,7 +410,7 @@ void TextSplitter::scanStringNoNewLine(const char *fmt, int field_count, ...) {
 	va_list va;
 	va_start(va, field_count);
 
-	parse(getCurrentLine(), fmt, field_count, va);
+	scan(0, fmt, field_count, va);
 
 	va_end(va);
 }
@@ -345,11 +422,83 @@ void TextSplitter::scanStringAtOffsetNoNewLine(int offset, const char *fmt, int
 	va_list va;
 	va_start(va, field_count);
 
-	parse(getCurrentLine() + offset, fmt, field_count, va);
+	scan(offset, fmt, field_count, va);
 
 	va_end(va);
 }
 
+void TextSplitter::scan(int offset, const char *fmt, int field_count, va_list va) {
+	if (_replayPos && replay(offset, fmt, va))
+		return;
+
+	if (_recording) {
+		appendUint32(_record, _lineIndex);
+		appendUint32(_record, offset);
+		appendUint32(_record, Common::hashit(fmt));
+	}
+	parse(getCurrentLine() + offset, fmt, field_count, va, _recording ? &_record : NULL);
+}
+
+bool TextSplitter::replay(int offset, const char *fmt, va_list va) {
+	// Each scan is stored as the line, the offset and the hash of the format,
+	// followed by the fields
+	if (_replayEnd - _replayPos < 12 || (int)READ_UINT32(_replayPos) != _lineIndex ||
+			(int)READ_UINT32(_replayPos + 4) != offset || READ_UINT32(_replayPos + 8) != Common::hashit(fmt)) {
+		warning("TextSplitter: The cached values of %s don't match, parsing it instead", _cacheName.c_str());
+		dropReplay();
+		return false;
+	}
+
+	// Check the whole scan before filling in any of the fields, so that a
+	// damaged entry can still be parsed from the text instead
+	const byte *pos = _replayPos + 12;
+	bool complete = false;
+	while (_replayEnd - pos >= 2) {
+		uint16 size = READ_UINT16(pos);
+		pos += 2;
+		if (size == kEndOfFields) {
+			complete = true;
+			break;
+		}
+
+		if (_replayEnd - pos < 2)
+			break;
+		uint16 length = READ_UINT16(pos);
+		pos += 2;
+		if (length > size || _replayEnd - pos < length)
+			break;
+		pos += length;
+	}
+	if (!complete) {
+		warning("TextSplitter: The cached values of %s are truncated, parsing it instead", _cacheName.c_str());
+		dropReplay();
+		return false;
+	}
+
+	_replayPos += 12;
+	while (true) {
+		uint16 size = READ_UINT16(_replayPos);
+		_replayPos += 2;
+		if (size == kEndOfFields)
+			return true;
+
+		uint16 length = READ_UINT16(_replayPos);
+		_replayPos += 2;
+		byte *var = va_arg(va, byte *);
+		memcpy(var, _replayPos, length);
+		memset(var + length, 0, size - length);
+		_replayPos += length;
+	}
+}
+
+void TextSplitter::dropReplay() {
+	// The rest of the resource is parsed, and it is recorded again the next
+	// time it is loaded
+	_replayPos = _replayEnd = NULL;
+	if (g_textCache)
+		g_textCache->remove(_cacheName);
+}
+
 void TextSplitter::processLine() {
 	if (isEof())
 		return;
@@ -23,6 +23,9 @@
 #ifndef GRIM_TEXTSPLIT_HH
 #define GRIM_TEXTSPLIT_HH
 
+#include "common/array.h"
+#include "common/str.h"
+
 namespace Common {
 class SeekableReadStream;
 }
@@ -36,6 +39,12 @@ namespace Grim {
 class TextSplitter {
 public:
 	TextSplitter(Common::SeekableReadStream *data);
+	/**
+	 * Like the other constructor, but the values scanned from the lines are
+	 * kept in the text cache under the given name, and are taken from there
+	 * instead of parsing the lines again when the same file is loaded later.
+	 */
+	TextSplitter(const Common::String &fname, Common::SeekableReadStream *data);
 	~TextSplitter();
 
 	char *nextLine() {
@@ -78,7 +87,18 @@ private:
 	int _numLines, _lineIndex;
 	char **_lines;
 
+	Common::String _cacheName;
+	uint32 _dataSize, _dataHash;
+	const byte *_replayPos, *_replayEnd;
+	// The values being recorded, or a copy of the cached ones being replayed
+	Common::Array<byte> _record;
+	bool _recording;
+
+	void init(Common::SeekableReadStream *data);
 	void processLine();
+	void scan(int offset, const char *fmt, int field_count, va_list va);
+	bool replay(int offset, const char *fmt, va_list va);
+	void dropReplay();
 };
 
 } // end of namespace Grim
@@ -31,6 +31,14 @@
 #include "graphics/VectorRenderer.h"
 #include "graphics/VectorRendererSpec.h"
 
+#if defined(__SSE2__)
+#define VECTOR_RENDERER_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VECTOR_RENDERER_USE_NEON
+#include <arm_neon.h>
+#endif
+
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
 /** Fixed point SQUARE ROOT **/
@@ -274,6 +282,188 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	}
 }
 
+/**
+ * Fills several pixels in a row alternating between two colors, starting
+ * with the first one. Used for the dithered rows of gradients.
+ */
+template<typename PixelType>
+void ditherFill(PixelType *first, PixelType *last, PixelType color1, PixelType color2) {
+	while (last - first >= 2) {
+		*first++ = color1;
+		*first++ = color2;
+	}
+
+	if (first != last)
+		*first = color1;
+}
+
+/**
+ * SPAN KERNELS
+ *
+ * The overlay is 16 bit on every backend, so these work on eight uint16
+ * pixels at a time with SSE2 or NEON. Each one handles as many whole
+ * vectors as fit in the span and returns the number of pixels done; the
+ * caller finishes the rest with the scalar code, so that both paths give
+ * the same pixels. The generic versions leave everything to the caller.
+ */
+template<typename PixelType>
+inline int blendSpan(PixelType *ptr, int count, PixelType color, uint8 alpha, const PixelFormat &format) {
+	return 0;
+}
+
+template<typename PixelType>
+inline int darkenSpan(PixelType *ptr, int count, PixelType keepMask, int shift, PixelType bits, bool add) {
+	return 0;
+}
+
+#if defined(VECTOR_RENDERER_USE_SSE2) || defined(VECTOR_RENDERER_USE_NEON)
+
+template<>
+void colorFill<uint16>(uint16 *first, uint16 *last, uint16 color) {
+#if defined(VECTOR_RENDERER_USE_SSE2)
+	const __m128i c = _mm_set1_epi16(color);
+	while (last - first >= 8) {
+		_mm_storeu_si128((__m128i *)first, c);
+		first += 8;
+	}
+#else
+	const uint16x8_t c = vdupq_n_u16(color);
+	while (last - first >= 8) {
+		vst1q_u16(first, c);
+		first += 8;
+	}
+#endif
+
+	while (first != last)
+		*first++ = color;
+}
+
+template<>
+void ditherFill<uint16>(uint16 *first, uint16 *last, uint16 color1, uint16 color2) {
+	const uint32 pair = color1 | (color2 << 16);
+#if defined(VECTOR_RENDERER_USE_SSE2)
+	const __m128i c = _mm_set1_epi32(pair);
+	while (last - first >= 8) {
+		_mm_storeu_si128((__m128i *)first, c);
+		first += 8;
+	}
+#else
+	const uint16x8_t c = vreinterpretq_u16_u32(vdupq_n_u32(pair));
+	while (last - first >= 8) {
+		vst1q_u16(first, c);
+		first += 8;
+	}
+#endif
+
+	while (last - first >= 2) {
+		*first++ = color1;
+		*first++ = color2;
+	}
+
+	if (first != last)
+		*first = color1;
+}
+
+/**
+ * Blends eight pixels at a time towards a color, one channel after the
+ * other in 16 bit lanes: dst + (((src - dst) * alpha) >> 8) is the same as
+ * blendPixelPtr() computes on the channels in place, as long as the product
+ * fits, i.e. for channels of up to six bits. The alpha bits are kept.
+ */
+inline int blendSpan(uint16 *ptr, int count, uint16 color, uint8 alpha, const PixelFormat &format) {
+	if (format.rLoss < 2 || format.gLoss < 2 || format.bLoss < 2)
+		return 0;
+
+	const int shifts[3] = { format.rShift, format.gShift, format.bShift };
+	const int widths[3] = { 0xFF >> format.rLoss, 0xFF >> format.gLoss, 0xFF >> format.bLoss };
+	const uint16 alphaMask = (uint16)((0xFF >> format.aLoss) << format.aShift);
+	int done = 0;
+
+#if defined(VECTOR_RENDERER_USE_SSE2)
+	const __m128i a = _mm_set1_epi16(alpha);
+	const __m128i keep = _mm_set1_epi16(alphaMask);
+	__m128i shift[3], width[3], src[3];
+	for (int c = 0; c < 3; c++) {
+		shift[c] = _mm_cvtsi32_si128(shifts[c]);
+		width[c] = _mm_set1_epi16(widths[c]);
+		src[c] = _mm_set1_epi16((color >> shifts[c]) & widths[c]);
+	}
+
+	for (; done + 8 <= count; done += 8) {
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(ptr + done));
+		__m128i out = _mm_and_si128(dst, keep);
+		for (int c = 0; c < 3; c++) {
+			__m128i d = _mm_and_si128(_mm_srl_epi16(dst, shift[c]), width[c]);
+			__m128i diff = _mm_mullo_epi16(_mm_sub_epi16(src[c], d), a);
+			d = _mm_add_epi16(d, _mm_srai_epi16(diff, 8));
+			out = _mm_or_si128(out, _mm_sll_epi16(d, shift[c]));
+		}
+		_mm_storeu_si128((__m128i *)(ptr + done), out);
+	}
+#else
+	const int16x8_t a = vdupq_n_s16(alpha);
+	const uint16x8_t keep = vdupq_n_u16(alphaMask);
+	int16x8_t shiftLeft[3], shiftRight[3];
+	uint16x8_t width[3];
+	int16x8_t src[3];
+	for (int c = 0; c < 3; c++) {
+		shiftLeft[c] = vdupq_n_s16(shifts[c]);
+		shiftRight[c] = vdupq_n_s16(-shifts[c]);
+		width[c] = vdupq_n_u16(widths[c]);
+		src[c] = vdupq_n_s16((color >> shifts[c]) & widths[c]);
+	}
+
+	for (; done + 8 <= count; done += 8) {
+		const uint16x8_t dst = vld1q_u16(ptr + done);
+		uint16x8_t out = vandq_u16(dst, keep);
+		for (int c = 0; c < 3; c++) {
+			int16x8_t d = vreinterpretq_s16_u16(vandq_u16(vshlq_u16(dst, shiftRight[c]), width[c]));
+			int16x8_t diff = vmulq_s16(vsubq_s16(src[c], d), a);
+			d = vaddq_s16(d, vshrq_n_s16(diff, 8));
+			out = vorrq_u16(out, vshlq_u16(vreinterpretq_u16_s16(d), shiftLeft[c]));
+		}
+		vst1q_u16(ptr + done, out);
+	}
+#endif
+
+	return done;
+}
+
+/**
+ * Shifts eight pixels at a time right after clearing the bits which would
+ * spill into the next channel, then ORs or adds the given bits; this is
+ * how the darkened and dimmed areas are drawn.
+ */
+inline int darkenSpan(uint16 *ptr, int count, uint16 keepMask, int shift, uint16 bits, bool add) {
+	int done = 0;
+
+#if defined(VECTOR_RENDERER_USE_SSE2)
+	const __m128i keep = _mm_set1_epi16(keepMask);
+	const __m128i b = _mm_set1_epi16(bits);
+	const __m128i s = _mm_cvtsi32_si128(shift);
+
+	for (; done + 8 <= count; done += 8) {
+		__m128i p = _mm_srl_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i *)(ptr + done)), keep), s);
+		p = add ? _mm_add_epi16(p, b) : _mm_or_si128(p, b);
+		_mm_storeu_si128((__m128i *)(ptr + done), p);
+	}
+#else
+	const uint16x8_t keep = vdupq_n_u16(keepMask);
+	const uint16x8_t b = vdupq_n_u16(bits);
+	const int16x8_t s = vdupq_n_s16(-shift);
+
+	for (; done + 8 <= count; done += 8) {
+		uint16x8_t p = vshlq_u16(vandq_u16(vld1q_u16(ptr + done), keep), s);
+		p = add ? vaddq_u16(p, b) : vorrq_u16(p, b);
+		vst1q_u16(ptr + done, p);
+	}
+#endif
+
+	return done;
+}
+
+#endif
+
 
 VectorRenderer *createRenderer(int mode) {
 #ifdef DISABLE_FANCY_THEMES
@@ -361,8 +551,15 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	int stripSize;
 	int curGrad = 0;
 
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
+	// Find the strip the row is in
+	int last = _gradIndexes.size() - 2;
+	while (curGrad < last) {
+		int mid = (curGrad + last) / 2;
+		if (_gradIndexes[mid + 1] <= y)
+			curGrad = mid + 1;
+		else
+			last = mid;
+	}
 
 	stripSize = _gradIndexes[curGrad + 1] - _gradIndexes[curGrad];
 
@@ -381,16 +578,18 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// The pattern only depends on the parity of the column
+		PixelType even = _gradCache[curGrad], odd = _gradCache[curGrad];
+
+		if ((grad == 2 || grad == 3) && ox)
+			even = _gradCache[curGrad + 1];
+		if (ox || grad == 3)
+			odd = _gradCache[curGrad + 1];
+
+		if (x & 1)
+			ditherFill<PixelType>(ptr, ptr + width, odd, even);
+		else
+			ditherFill<PixelType>(ptr, ptr + width, even, odd);
 	}
 }
 
@@ -520,7 +719,9 @@ applyScreenShading(GUI::ThemeEngine::ShadingStyle shadingStyle) {
 	if (shadingStyle == GUI::ThemeEngine::kShadingDim) {
 
 		// TODO: Check how this interacts with kFeatureOverlaySupportsAlpha
-		for (int i = 0; i < pixels; ++i) {
+		int done = darkenSpan(ptr, pixels, (PixelType)colorMask, 1, _alphaMask, false);
+		ptr += done;
+		for (int i = done; i < pixels; ++i) {
 			*ptr = ((*ptr & colorMask) >> 1) | _alphaMask;
 			++ptr;
 		}
@@ -570,6 +771,15 @@ blendPixelDestAlphaPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	first += blendSpan(first, last - first, color, alpha, _format);
+
+	while (first != last)
+		blendPixelPtr(first++, color, alpha);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 darkenFill(PixelType *ptr, PixelType *end) {
@@ -578,6 +788,7 @@ darkenFill(PixelType *ptr, PixelType *end) {
 	if (!g_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha)) {
 		// !kFeatureOverlaySupportsAlpha (but might have alpha bits)
 
+		ptr += darkenSpan(ptr, end - ptr, (PixelType)~mask, 2, _alphaMask, false);
 		while (ptr != end) {
 			*ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
 			++ptr;
@@ -590,6 +801,7 @@ darkenFill(PixelType *ptr, PixelType *end) {
 		PixelType addA = (PixelType)(255 >> _format.aLoss) << _format.aShift;
 		addA -= (addA >> 2);
 
+		ptr += darkenSpan(ptr, end - ptr, (PixelType)~mask, 2, addA, true);
 		while (ptr != end) {
 			// Darken the colour, and increase the alpha
 			// (0% -> 75%, 100% -> 100%)
@@ -1616,9 +1828,7 @@ drawSquareShadow(int x, int y, int w, int h, int blur) {
 	ptr = (PixelType *)_activeSurface->getBasePtr(x + blur, y + h - 1);
 
 	while (i++ < blur) {
-		j = w - blur;
-		while (j--)
-			blendPixelPtr(ptr + j, 0, ((blur - i) << 8) / blur);
+		blendFill(ptr, ptr + w - blur, 0, ((blur - i) << 8) / blur);
 		ptr += pitch;
 	}
 
@@ -215,9 +215,7 @@ protected:
 	 * @param color Color of the pixel
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
-	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
-		while (first != last) blendPixelPtr(first++, color, alpha);
-	}
+	void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha);
 
 	void darkenFill(PixelType *first, PixelType *last);
 
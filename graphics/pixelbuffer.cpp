@@ -20,26 +20,203 @@
  *
  */
 
+#include "common/endian.h"
+#include "common/util.h"
+
 #include "graphics/pixelbuffer.h"
 
 namespace Graphics {
 
+/*
+ * Format conversion kernels.
+ *
+ * A kernel converts a run of pixels with the very same arithmetic as
+ * PixelFormat::colorToARGB() and ARGBToColor(), so the results match the
+ * generic per pixel path bit for bit. The formats are described by policy
+ * classes: StaticFormat has all its shifts and losses known at compile
+ * time, for the pairs used all the time (16 bit screens and overlays,
+ * 32 bit textures), while DynamicFormat reads them from a PixelFormat and
+ * only has the pixel size fixed, which still saves the byte loops and
+ * function calls of the generic path.
+ */
+
+template<int bpp>
+struct PixelIO;
+
+template<>
+struct PixelIO<2> {
+	static inline uint32 read(const byte *p) { return READ_UINT16(p); }
+	static inline void write(byte *p, uint32 value) { WRITE_UINT16(p, value); }
+};
+
+template<>
+struct PixelIO<3> {
+#if defined(SCUMM_BIG_ENDIAN)
+	static inline uint32 read(const byte *p) { return (p[0] << 16) | (p[1] << 8) | p[2]; }
+	static inline void write(byte *p, uint32 value) {
+		p[0] = (value >> 16) & 0xFF;
+		p[1] = (value >> 8) & 0xFF;
+		p[2] = value & 0xFF;
+	}
+#else
+	static inline uint32 read(const byte *p) { return p[0] | (p[1] << 8) | (p[2] << 16); }
+	static inline void write(byte *p, uint32 value) {
+		p[0] = value & 0xFF;
+		p[1] = (value >> 8) & 0xFF;
+		p[2] = (value >> 16) & 0xFF;
+	}
+#endif
+};
+
+template<>
+struct PixelIO<4> {
+	static inline uint32 read(const byte *p) { return READ_UINT32(p); }
+	static inline void write(byte *p, uint32 value) { WRITE_UINT32(p, value); }
+};
+
+template<int Bpp, int RBits, int GBits, int BBits, int ABits, int RShift, int GShift, int BShift, int AShift>
+struct StaticFormat {
+	enum { kBytesPerPixel = Bpp };
+
+	StaticFormat(const PixelFormat &) {}
+
+	static bool matches(const PixelFormat &format) {
+		return format == PixelFormat(Bpp, RBits, GBits, BBits, ABits, RShift, GShift, BShift, AShift);
+	}
+
+	inline int rLoss() const { return 8 - RBits; }
+	inline int gLoss() const { return 8 - GBits; }
+	inline int bLoss() const { return 8 - BBits; }
+	inline int aLoss() const { return 8 - ABits; }
+	inline int rShift() const { return RShift; }
+	inline int gShift() const { return GShift; }
+	inline int bShift() const { return BShift; }
+	inline int aShift() const { return AShift; }
+};
+
+template<int Bpp>
+struct DynamicFormat {
+	enum { kBytesPerPixel = Bpp };
+
+	DynamicFormat(const PixelFormat &format) : _format(format) {}
+
+	inline int rLoss() const { return _format.rLoss; }
+	inline int gLoss() const { return _format.gLoss; }
+	inline int bLoss() const { return _format.bLoss; }
+	inline int aLoss() const { return _format.aLoss; }
+	inline int rShift() const { return _format.rShift; }
+	inline int gShift() const { return _format.gShift; }
+	inline int bShift() const { return _format.bShift; }
+	inline int aShift() const { return _format.aShift; }
+
+	const PixelFormat &_format;
+};
+
+// 5-6-5, as used by the overlay, the 16 bit screens and the game bitmaps
+typedef StaticFormat<2, 5, 6, 5, 0, 11, 5, 0, 0> Format565;
+// R, G, B, A in memory, on little endian systems
+typedef StaticFormat<4, 8, 8, 8, 8, 0, 8, 16, 24> FormatABGR8888;
+// B, G, R, A in memory, on little endian systems
+typedef StaticFormat<4, 8, 8, 8, 8, 16, 8, 0, 24> FormatARGB8888;
+typedef StaticFormat<4, 8, 8, 8, 8, 24, 16, 8, 0> FormatRGBA8888;
+typedef StaticFormat<3, 8, 8, 8, 0, 16, 8, 0, 0> FormatRGB888;
+typedef StaticFormat<3, 8, 8, 8, 0, 0, 8, 16, 0> FormatBGR888;
+
+enum ConversionMode {
+	kConvertRGB,	// What copyBuffer() does: the alpha of the source is dropped
+	kConvertKeyed	// What setPixelAt() does, but leaving the key color alone
+};
+
+template<class Src, class Dst, int mode>
+static void convertPixels(byte *dst, const PixelFormat &dstFormat, const byte *src, const PixelFormat &srcFormat, int length, uint32 key) {
+	const Src s(srcFormat);
+	const Dst d(dstFormat);
+
+	for (int i = 0; i < length; ++i) {
+		const uint32 color = PixelIO<Src::kBytesPerPixel>::read(src);
+		uint32 value;
+		if (mode == kConvertKeyed && color == key) {
+			value = key;
+		} else {
+			uint8 a = 0xFF;
+			if (mode != kConvertRGB && s.aLoss() != 8)
+				a = ((color >> s.aShift()) << s.aLoss()) & 0xFF;
+			const uint8 r = ((color >> s.rShift()) << s.rLoss()) & 0xFF;
+			const uint8 g = ((color >> s.gShift()) << s.gLoss()) & 0xFF;
+			const uint8 b = ((color >> s.bShift()) << s.bLoss()) & 0xFF;
+			value = ((a >> d.aLoss()) << d.aShift()) |
+			        ((r >> d.rLoss()) << d.rShift()) |
+			        ((g >> d.gLoss()) << d.gShift()) |
+			        ((b >> d.bLoss()) << d.bShift());
+		}
+		PixelIO<Dst::kBytesPerPixel>::write(dst, value);
+		src += Src::kBytesPerPixel;
+		dst += Dst::kBytesPerPixel;
+	}
+}
+
+typedef void (*ConvertFunc)(byte *dst, const PixelFormat &dstFormat, const byte *src, const PixelFormat &srcFormat, int length, uint32 key);
+typedef bool (*MatchFunc)(const PixelFormat &format);
+
+struct PixelConversion {
+	MatchFunc srcMatches;
+	MatchFunc dstMatches;
+	ConvertFunc convert;
+	ConvertFunc convertKeyed;
+};
+
+#define CONVERSION(src, dst) \
+	{ &src::matches, &dst::matches, &convertPixels<src, dst, kConvertRGB>, &convertPixels<src, dst, kConvertKeyed> }
+
+static const PixelConversion s_conversions[] = {
+	CONVERSION(Format565, FormatABGR8888),
+	CONVERSION(Format565, FormatARGB8888),
+	CONVERSION(Format565, FormatRGBA8888),
+	CONVERSION(FormatABGR8888, Format565),
+	CONVERSION(FormatARGB8888, Format565),
+	CONVERSION(FormatRGBA8888, Format565),
+	CONVERSION(FormatABGR8888, FormatARGB8888),
+	CONVERSION(FormatARGB8888, FormatABGR8888),
+	CONVERSION(FormatRGB888, FormatABGR8888),
+	CONVERSION(FormatRGB888, FormatARGB8888),
+	CONVERSION(FormatRGB888, FormatRGBA8888),
+	CONVERSION(FormatBGR888, FormatABGR8888),
+	CONVERSION(FormatBGR888, FormatARGB8888)
+};
+
+#undef CONVERSION
+
+#define CONVERSION(src, dst) \
+	{ 0, 0, &convertPixels<DynamicFormat<src>, DynamicFormat<dst>, kConvertRGB>, &convertPixels<DynamicFormat<src>, DynamicFormat<dst>, kConvertKeyed> }
+
+// Any other pair, by pixel size, starting from 2 bytes per pixel
+static const PixelConversion s_sizedConversions[3][3] = {
+	{ CONVERSION(2, 2), CONVERSION(2, 3), CONVERSION(2, 4) },
+	{ CONVERSION(3, 2), CONVERSION(3, 3), CONVERSION(3, 4) },
+	{ CONVERSION(4, 2), CONVERSION(4, 3), CONVERSION(4, 4) }
+};
+
+#undef CONVERSION
+
 PixelBuffer::PixelBuffer()
 	: _buffer(NULL),
-	  _dispose(DisposeAfterUse::NO) {
+	  _dispose(DisposeAfterUse::NO),
+	  _conversion(NULL) {
 
 }
 
 PixelBuffer::PixelBuffer(const PixelFormat &format, int buffersize, DisposeAfterUse::Flag dispose)
 	: _buffer(NULL),
-	_dispose(DisposeAfterUse::NO) {
+	_dispose(DisposeAfterUse::NO),
+	_conversion(NULL) {
 	create(format, buffersize, dispose);
 }
 
 PixelBuffer::PixelBuffer(const PixelFormat &format, byte *buffer)
 	: _buffer(buffer),
 	  _format(format),
-	  _dispose(DisposeAfterUse::NO) {
+	  _dispose(DisposeAfterUse::NO),
+	  _conversion(NULL) {
 
 }
 
@@ -59,6 +236,8 @@ void PixelBuffer::create(const Graphics::PixelFormat &format, int buffersize, Di
 	_format = format;
 	_dispose = dispose;
 	_buffer = new byte[buffersize * format.bytesPerPixel];
+	_conversion = NULL;
+	_conversionFormat = PixelFormat();
 }
 
 void PixelBuffer::create(int buffersize, DisposeAfterUse::Flag dispose) {
@@ -75,6 +254,8 @@ void PixelBuffer::set(const Graphics::PixelFormat &format, byte *buffer) {
 
 	_format = format;
 	_buffer = buffer;
+	_conversion = NULL;
+	_conversionFormat = PixelFormat();
 }
 
 void PixelBuffer::free() {
@@ -87,6 +268,17 @@ void PixelBuffer::clear(int length) {
 }
 
 void PixelBuffer::setPixelAt(int pixel, uint32 value) {
+	switch (_format.bytesPerPixel) {
+	case 2:
+		PixelIO<2>::write(_buffer + pixel * 2, value);
+		return;
+	case 4:
+		PixelIO<4>::write(_buffer + pixel * 4, value);
+		return;
+	default:
+		break;
+	}
+
 #if defined(SCUMM_BIG_ENDIAN)
 	byte *buffer = _buffer + pixel * _format.bytesPerPixel;
 	for (int i = 0; i < _format.bytesPerPixel; ++i) {
@@ -100,9 +292,34 @@ void PixelBuffer::setPixelAt(int pixel, uint32 value) {
 #endif
 }
 
+const PixelConversion *PixelBuffer::getConversion(const PixelFormat &format) {
+	if (_conversionFormat == format)
+		return _conversion;
+
+	_conversionFormat = format;
+	_conversion = NULL;
+	for (int i = 0; i < ARRAYSIZE(s_conversions); ++i) {
+		if (s_conversions[i].srcMatches(format) && s_conversions[i].dstMatches(_format)) {
+			_conversion = &s_conversions[i];
+			return _conversion;
+		}
+	}
+
+	if (format.bytesPerPixel >= 2 && format.bytesPerPixel <= 4 &&
+	    _format.bytesPerPixel >= 2 && _format.bytesPerPixel <= 4)
+		_conversion = &s_sizedConversions[format.bytesPerPixel - 2][_format.bytesPerPixel - 2];
+	return _conversion;
+}
+
 void PixelBuffer::copyBuffer(int thisFrom, int otherFrom, int length, const PixelBuffer &buf) {
 	if (buf._format == _format) {
 		memcpy(_buffer + thisFrom * _format.bytesPerPixel, buf._buffer + otherFrom * _format.bytesPerPixel, length * _format.bytesPerPixel);
+		return;
+	}
+
+	const PixelConversion *conversion = getConversion(buf._format);
+	if (conversion) {
+		conversion->convert(getRawBuffer(thisFrom), _format, buf.getRawBuffer(otherFrom), buf._format, length, 0);
 	} else {
 		uint8 r, g, b;
 		for (int i = 0; i < length; ++i) {
@@ -112,7 +329,35 @@ void PixelBuffer::copyBuffer(int thisFrom, int otherFrom, int length, const Pixe
 	}
 }
 
+void PixelBuffer::copyBufferKeyed(int thisFrom, int otherFrom, int length, const PixelBuffer &buf, uint32 key) {
+	if (buf._format == _format) {
+		memcpy(_buffer + thisFrom * _format.bytesPerPixel, buf._buffer + otherFrom * _format.bytesPerPixel, length * _format.bytesPerPixel);
+		return;
+	}
+
+	const PixelConversion *conversion = getConversion(buf._format);
+	if (conversion) {
+		conversion->convertKeyed(getRawBuffer(thisFrom), _format, buf.getRawBuffer(otherFrom), buf._format, length, key);
+	} else {
+		for (int i = 0; i < length; ++i) {
+			if (buf.getValueAt(i + otherFrom) == key)
+				setPixelAt(i + thisFrom, key);
+			else
+				setPixelAt(i + thisFrom, buf, i + otherFrom);
+		}
+	}
+}
+
 uint32 PixelBuffer::getValueAt(int i) const {
+	switch (_format.bytesPerPixel) {
+	case 2:
+		return PixelIO<2>::read(_buffer + i * 2);
+	case 4:
+		return PixelIO<4>::read(_buffer + i * 4);
+	default:
+		break;
+	}
+
 #if defined(SCUMM_BIG_ENDIAN)
 	byte *buffer = _buffer + i * _format.bytesPerPixel;
 	uint32 p = buffer[0] << ((_format.bytesPerPixel - 1) * 8);
@@ -134,6 +379,8 @@ PixelBuffer &PixelBuffer::operator=(const PixelBuffer &buf) {
 	_buffer = buf._buffer;
 	_format = buf._format;
 	_dispose = DisposeAfterUse::NO;
+	_conversion = NULL;
+	_conversionFormat = PixelFormat();
 
 	return *this;
 }
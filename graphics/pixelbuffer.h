@@ -30,6 +30,8 @@
 
 namespace Graphics {
 
+struct PixelConversion;
+
 class PixelBuffer {
 public:
 	/**
@@ -170,6 +172,18 @@ public:
 	 * @param buf The source buffer.
 	 */
 	void copyBuffer(int thisFrom, int otherFrom, int length, const PixelBuffer &buf);
+	/**
+	 * Copy some pixels from a buffer, converting them like setPixelAt() does, except that
+	 * the source pixels whose value is 'key' are stored as 'key', unconverted. This keeps
+	 * the transparent color of an image recognizable after changing its format.
+	 *
+	 * @param thisFrom The starting index.
+	 * @param otherFrom The starting index in the source buffer.
+	 * @param length The number of pixels to copy.
+	 * @param buf The source buffer.
+	 * @param key The value of the transparent pixels.
+	 */
+	void copyBufferKeyed(int thisFrom, int otherFrom, int length, const PixelBuffer &buf, uint32 key);
 
 	/**
 	 * Shift the internal buffer of some pixels, losing some pixels at the start of the buffer.
@@ -224,9 +238,18 @@ public:
 	inline operator bool() const { return (_buffer); }
 
 private:
+	/**
+	 * Return the specialized conversion from the given format to the format of
+	 * this buffer, or NULL if only the generic per pixel path can do it.
+	 * The result is remembered for the next copy from the same format.
+	 */
+	const PixelConversion *getConversion(const Graphics::PixelFormat &format);
+
 	byte *_buffer;
 	Graphics::PixelFormat _format;
 	DisposeAfterUse::Flag _dispose;
+	const PixelConversion *_conversion;
+	Graphics::PixelFormat _conversionFormat;
 };
 
 }
@@ -66,6 +66,7 @@ void gl_draw_point(GLContext *c, GLVertex *p0) {
 		if (c->render_mode == TGL_SELECT) {
 			gl_add_select(c,p0->zp.z,p0->zp.z);
 		} else {
+			ZB_addDrawnPoint(c->zb, &p0->zp);
 			ZB_plot(c->zb,&p0->zp);
 		}
 	}
@@ -122,6 +123,8 @@ void gl_draw_line(GLContext *c, GLVertex *p1, GLVertex *p2) {
 		if (c->render_mode == TGL_SELECT) {
 			gl_add_select1(c,p1->zp.z,p2->zp.z,p2->zp.z);
 	} else {
+		ZB_addDrawnPoint(c->zb, &p1->zp);
+		ZB_addDrawnPoint(c->zb, &p2->zp);
 		if (c->depth_test)
 			ZB_line_z(c->zb,&p1->zp,&p2->zp);
 		else
@@ -152,6 +155,8 @@ void gl_draw_line(GLContext *c, GLVertex *p1, GLVertex *p2) {
 			gl_transform_to_viewport(c,&q1);
 			gl_transform_to_viewport(c,&q2);
 
+			ZB_addDrawnPoint(c->zb, &q1.zp);
+			ZB_addDrawnPoint(c->zb, &q2.zp);
 			if (c->depth_test)
 				ZB_line_z(c->zb,&q1.zp,&q2.zp);
 			else
@@ -387,6 +392,10 @@ void gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p
 	}
 #endif
 
+	ZB_addDrawnPoint(c->zb, &p0->zp);
+	ZB_addDrawnPoint(c->zb, &p1->zp);
+	ZB_addDrawnPoint(c->zb, &p2->zp);
+
 	if (c->shadow_mode & 1) {
 		assert(c->zb->shadow_mask_buf);
 		ZB_fillTriangleFlatShadowMask(c->zb, &p0->zp, &p1->zp, &p2->zp);
@@ -409,6 +418,9 @@ void gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p
 // Render a clipped triangle in line mode
 
 void gl_draw_triangle_line(GLContext *c, GLVertex *p0, GLVertex *p1,GLVertex *p2) {
+	ZB_addDrawnPoint(c->zb, &p0->zp);
+	ZB_addDrawnPoint(c->zb, &p1->zp);
+	ZB_addDrawnPoint(c->zb, &p2->zp);
 	if (c->depth_test) {
 		if (p0->edge_flag)
 			ZB_line_z(c->zb, &p0->zp, &p1->zp);
@@ -428,6 +440,9 @@ void gl_draw_triangle_line(GLContext *c, GLVertex *p0, GLVertex *p1,GLVertex *p2
 
 // Render a clipped triangle in point mode
 void gl_draw_triangle_point(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2) {
+	ZB_addDrawnPoint(c->zb, &p0->zp);
+	ZB_addDrawnPoint(c->zb, &p1->zp);
+	ZB_addDrawnPoint(c->zb, &p2->zp);
 	if (p0->edge_flag)
 		ZB_plot(c->zb, &p0->zp);
 	if (p1->edge_flag)
@@ -57,6 +57,8 @@ ZBuffer *ZB_open(int xsize, int ysize, const Graphics::PixelBuffer &frame_buffer
 	zb->buffers[1].zbuf = NULL;
 	zb->buffers[1].used = false;
 
+	ZB_resetDrawnArea(zb);
+
 	return zb;
 error:
 	gl_free(zb);
@@ -227,4 +229,11 @@ void ZB_clearOffscreenBuffer(ZBuffer *zb) {
 	}
 }
 
+void ZB_resetDrawnArea(ZBuffer *zb) {
+	zb->drawn_x1 = zb->xsize;
+	zb->drawn_y1 = zb->ysize;
+	zb->drawn_x2 = -1;
+	zb->drawn_y2 = -1;
+}
+
 } // end of namespace TinyGL
@@ -59,6 +59,9 @@ typedef struct {
 	unsigned char *dctable;
 	int *ctable;
 	Graphics::PixelBuffer current_texture;
+	// Bounding box of the points rasterized since ZB_resetDrawnArea,
+	// empty if drawn_x1 > drawn_x2
+	int drawn_x1, drawn_y1, drawn_x2, drawn_y2;
 } ZBuffer;
 
 typedef struct {
@@ -69,6 +72,17 @@ typedef struct {
 	float sz,tz;   // temporary coordinates for mapping
 } ZBufferPoint;
 
+static inline void ZB_addDrawnPoint(ZBuffer *zb, const ZBufferPoint *p) {
+	if (p->x < zb->drawn_x1)
+		zb->drawn_x1 = p->x;
+	if (p->x > zb->drawn_x2)
+		zb->drawn_x2 = p->x;
+	if (p->y < zb->drawn_y1)
+		zb->drawn_y1 = p->y;
+	if (p->y > zb->drawn_y2)
+		zb->drawn_y2 = p->y;
+}
+
 // zbuffer.c
 
 void ZB_selectScreenBuffer(ZBuffer *zb);
@@ -81,6 +95,12 @@ void ZB_selectOffscreenBuffer(ZBuffer *zb);
 void ZB_blitOffscreenBuffer(ZBuffer *zb);
 void ZB_clearOffscreenBuffer(ZBuffer *zb);
 
+/**
+ * Empty the bounding box of the rasterized points, so that it can be used
+ * to find which part of the screen some primitives were drawn to.
+ */
+void ZB_resetDrawnArea(ZBuffer *zb);
+
 ZBuffer *ZB_open(int xsize, int ysize, const Graphics::PixelBuffer &buffer);
 void ZB_close(ZBuffer *zb);
 void ZB_resize(ZBuffer *zb, void *frame_buffer, int xsize, int ysize);
@@ -59,7 +59,33 @@ struct TextColorData {
 	int r, g, b;
 };
 
+/**
+ * A DrawData item as it was drawn once, along with the pixels it was drawn
+ * over, so that the same item drawn over the same pixels can be blitted.
+ */
+struct CachedDrawData {
+	int16 _width, _height;
+	uint32 _dynamicData;
+	bool _oddColumn; ///< Gradients are dithered by screen column
+	bool _shadows;
+
+	Graphics::Surface _background;
+	Graphics::Surface _rendering;
+
+	~CachedDrawData() {
+		_background.free();
+		_rendering.free();
+	}
+
+	uint32 size() const {
+		return _background.pitch * _background.h + _rendering.pitch * _rendering.h;
+	}
+};
+
 struct WidgetDrawData {
+	WidgetDrawData() : _cacheable(false) {}
+	~WidgetDrawData() { clearCache(); }
+
 	/** List of all the steps needed to draw this widget */
 	Common::List<Graphics::DrawStep> _steps;
 
@@ -75,6 +101,17 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the drawing only depends on the size of the widget and the
+	    pixels beneath it, so that it can be cached */
+	bool _cacheable;
+
+	/** Recent renderings of this widget, most recently used first */
+	Common::List<CachedDrawData *> _cache;
+
+	enum {
+		kMaxCachedRenderings = 4
+	};
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -84,6 +121,20 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Works out whether the renderings of this DrawData item can be cached.
+	 * That is not the case when a step may draw outside of the widget area,
+	 * or uses a color set by whatever was drawn before.
+	 */
+	void calcCacheable();
+
+	/**
+	 * Frees all the cached renderings.
+	 *
+	 * @return Memory released, in bytes.
+	 */
+	uint32 clearCache();
 };
 
 class ThemeItem {
@@ -102,14 +153,14 @@ protected:
 
 class ThemeItemDrawData : public ThemeItem {
 public:
-	ThemeItemDrawData(ThemeEngine *engine, const WidgetDrawData *data, const Common::Rect &area, uint32 dynData) :
+	ThemeItemDrawData(ThemeEngine *engine, WidgetDrawData *data, const Common::Rect &area, uint32 dynData) :
 		ThemeItem(engine, area), _dynamicData(dynData), _data(data) {}
 
 	void drawSelf(bool draw, bool restore);
 
 protected:
 	uint32 _dynamicData;
-	const WidgetDrawData *_data;
+	WidgetDrawData *_data;
 };
 
 class ThemeItemTextData : public ThemeItem {
@@ -223,11 +274,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawDrawData(_data, _area, extendedRect, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -266,7 +314,7 @@ void ThemeItemBitmap::drawSelf(bool draw, bool restore) {
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
 	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
-	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
+	_font(0), _cachedDDBytes(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(0) {
 
 	_system = g_system;
@@ -506,6 +554,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	uint32 width = _system->getOverlayWidth();
 	uint32 height = _system->getOverlayHeight();
 
+	clearDrawDataCache();
+
 	_backBuffer.free();
 	_backBuffer.create(width, height, _overlayFormat);
 
@@ -531,6 +581,129 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_backgroundOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	bool fgColor = false, bgColor = false, gradient = false, bevelColor = false;
+
+	_cacheable = !_steps.empty();
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		fgColor |= step->fgColor.set;
+		bgColor |= step->bgColor.set;
+		gradient |= step->gradColor1.set && step->gradColor2.set;
+		bevelColor |= step->bevelColor.set;
+
+		// Steps placed by hand may reach out of the dirty area, and scaled
+		// ones depend on where the widget is
+		if (!step->autoWidth || !step->autoHeight || step->padding.left != 0 || step->padding.top != 0 ||
+		        (step->scale != 0 && step->scale != (1 << 16)) ||
+		        step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+			_cacheable = false;
+
+		if (!fgColor ||
+		        (step->fillMode == Graphics::VectorRenderer::kFillBackground && !bgColor) ||
+		        (step->fillMode == Graphics::VectorRenderer::kFillGradient && !gradient) ||
+		        ((step->bevel || step->drawingCall == &Graphics::VectorRenderer::drawCallback_BEVELSQ) && !bevelColor))
+			_cacheable = false;
+	}
+}
+
+uint32 WidgetDrawData::clearCache() {
+	uint32 size = 0;
+
+	for (Common::List<CachedDrawData *>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
+		size += (*i)->size();
+		delete *i;
+	}
+	_cache.clear();
+
+	return size;
+}
+
+static void copyArea(Graphics::Surface &dst, const Graphics::Surface &src, const Common::Rect &r) {
+	dst.create(r.width(), r.height(), src.format);
+	for (int y = 0; y < r.height(); ++y)
+		memcpy(dst.getBasePtr(0, y), src.getBasePtr(r.left, r.top + y), r.width() * src.format.bytesPerPixel);
+}
+
+static bool sameArea(const Graphics::Surface &copy, const Graphics::Surface &src, const Common::Rect &r) {
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(copy.getBasePtr(0, y), src.getBasePtr(r.left, r.top + y), r.width() * src.format.bytesPerPixel))
+			return false;
+	}
+	return true;
+}
+
+void ThemeEngine::drawDrawData(WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic) {
+	Graphics::Surface *surface = _vectorRenderer->getActiveSurface();
+	const bool shadows = !_vectorRenderer->shadowsDisabled();
+	const bool oddColumn = (area.left & 1) != 0;
+	Common::List<Graphics::DrawStep>::const_iterator step;
+
+	bool cacheable = data->_cacheable && extendedRect.left >= 0 && extendedRect.top >= 0 &&
+	                 extendedRect.right <= surface->w && extendedRect.bottom <= surface->h;
+
+	if (cacheable) {
+		for (Common::List<CachedDrawData *>::iterator i = data->_cache.begin(); i != data->_cache.end(); ++i) {
+			CachedDrawData *cached = *i;
+			if (cached->_width != area.width() || cached->_height != area.height() ||
+			        cached->_dynamicData != dynamic || cached->_oddColumn != oddColumn || cached->_shadows != shadows ||
+			        !sameArea(cached->_background, *surface, extendedRect))
+				continue;
+
+			_vectorRenderer->blitSubSurface(&cached->_rendering, extendedRect);
+
+			// Leave the renderer in the state drawing the steps would have
+			for (step = data->_steps.begin(); step != data->_steps.end(); ++step) {
+				Graphics::DrawStep state = *step;
+				state.drawingCall = &Graphics::VectorRenderer::drawCallback_VOID;
+				_vectorRenderer->drawStep(area, state, dynamic);
+			}
+
+			data->_cache.erase(i);
+			data->_cache.push_front(cached);
+			return;
+		}
+	}
+
+	CachedDrawData *cached = 0;
+	const uint32 size = 2 * extendedRect.width() * extendedRect.height() * surface->format.bytesPerPixel;
+
+	if (cacheable && _cachedDDBytes + size <= kDrawDataCacheBytes) {
+		cached = new CachedDrawData;
+		cached->_width = area.width();
+		cached->_height = area.height();
+		cached->_dynamicData = dynamic;
+		cached->_oddColumn = oddColumn;
+		cached->_shadows = shadows;
+		copyArea(cached->_background, *surface, extendedRect);
+	}
+
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+		_vectorRenderer->drawStep(area, *step, dynamic);
+
+	if (cached) {
+		copyArea(cached->_rendering, *surface, extendedRect);
+		data->_cache.push_front(cached);
+		_cachedDDBytes += cached->size();
+
+		if (data->_cache.size() > WidgetDrawData::kMaxCachedRenderings) {
+			CachedDrawData *oldest = data->_cache.back();
+			data->_cache.pop_back();
+			_cachedDDBytes -= oldest->size();
+			delete oldest;
+		}
+	}
+}
+
+void ThemeEngine::clearDrawDataCache() {
+	for (int i = 0; i < kDrawDataMAX; ++i) {
+		if (_widgets[i])
+			_widgets[i]->clearCache();
+	}
+
+	_cachedDDBytes = 0;
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
@@ -691,6 +864,7 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 }
@@ -699,6 +873,8 @@ void ThemeEngine::unloadTheme() {
 	if (!_themeOk)
 		return;
 
+	clearDrawDataCache();
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = 0;
@@ -249,6 +249,9 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Most memory the cached renderings of DrawData items may take, in bytes */
+	static const uint32 kDrawDataCacheBytes = 8 * 1024 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -513,6 +516,18 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws all the steps of a DrawData item on the active surface of the
+	 * renderer. If the item was drawn before with the same size and state
+	 * over the same pixels, the earlier rendering is blitted instead.
+	 *
+	 * @param data DrawData item to draw.
+	 * @param area Area of the widget.
+	 * @param extendedRect Area the steps may draw to, including shadows.
+	 * @param dynamic Dynamic data of the item.
+	 */
+	void drawDrawData(WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -549,6 +564,9 @@ protected:
 	 */
 	void unloadTheme();
 
+	/** Frees the cached renderings of all DrawData items. */
+	void clearDrawDataCache();
+
 	const Graphics::Font *loadScalableFont(const Common::String &filename, const Common::String &charset, const int pointsize, Common::String &name);
 	const Graphics::Font *loadFont(const Common::String &filename, Common::String &name);
 	Common::String genCacheFilename(const Common::String &filename) const;
@@ -636,6 +654,9 @@ protected:
 	Common::String _fontName;
 	const Graphics::Font *_font;
 
+	/** Memory taken by the cached renderings of DrawData items, in bytes */
+	uint32 _cachedDDBytes;
+
 	/**
 	 * Array of all the DrawData elements than can be drawn to the screen.
 	 * Must be full so the renderer can work.
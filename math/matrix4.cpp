@@ -24,6 +24,14 @@
 #include "math/vector4d.h"
 #include "math/squarematrix.h"
 
+#if defined(__SSE2__)
+#define MATH_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MATH_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Math {
 
 Matrix<4, 4>::Matrix() :
@@ -37,15 +45,111 @@ Matrix<4, 4>::Matrix(const MatrixBase<4, 4> &m) :
 }
 
 void Matrix<4, 4>::transform(Vector3d *v, bool trans) const {
-	Vector4d m;
-	m(0, 0) = v->x();
-	m(1, 0) = v->y();
-	m(2, 0) = v->z();
-	m(3, 0) = (trans ? 1.f : 0.f);
+	const float x = v->x(), y = v->y(), z = v->z();
+	const float w = trans ? 1.f : 0.f;
+
+	v->set(getValue(0, 0) * x + getValue(0, 1) * y + getValue(0, 2) * z + getValue(0, 3) * w,
+	       getValue(1, 0) * x + getValue(1, 1) * y + getValue(1, 2) * z + getValue(1, 3) * w,
+	       getValue(2, 0) * x + getValue(2, 1) * y + getValue(2, 2) * z + getValue(2, 3) * w);
+}
+
+void Matrix<4, 4>::transformPoints(const float *x, const float *y, const float *z, float *outX, float *outY, float *outZ, int count, bool trans) const {
+	const float m00 = getValue(0, 0), m01 = getValue(0, 1), m02 = getValue(0, 2);
+	const float m10 = getValue(1, 0), m11 = getValue(1, 1), m12 = getValue(1, 2);
+	const float m20 = getValue(2, 0), m21 = getValue(2, 1), m22 = getValue(2, 2);
+	const float tx = trans ? getValue(0, 3) : 0.f;
+	const float ty = trans ? getValue(1, 3) : 0.f;
+	const float tz = trans ? getValue(2, 3) : 0.f;
+	int i = 0;
+
+#if defined(MATH_USE_SSE2)
+	const __m128 r00 = _mm_set1_ps(m00), r01 = _mm_set1_ps(m01), r02 = _mm_set1_ps(m02);
+	const __m128 r10 = _mm_set1_ps(m10), r11 = _mm_set1_ps(m11), r12 = _mm_set1_ps(m12);
+	const __m128 r20 = _mm_set1_ps(m20), r21 = _mm_set1_ps(m21), r22 = _mm_set1_ps(m22);
+	const __m128 rtx = _mm_set1_ps(tx), rty = _mm_set1_ps(ty), rtz = _mm_set1_ps(tz);
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+		_mm_storeu_ps(outX + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, vx), _mm_mul_ps(r01, vy)), _mm_mul_ps(r02, vz)), rtx));
+		_mm_storeu_ps(outY + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r10, vx), _mm_mul_ps(r11, vy)), _mm_mul_ps(r12, vz)), rty));
+		_mm_storeu_ps(outZ + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r20, vx), _mm_mul_ps(r21, vy)), _mm_mul_ps(r22, vz)), rtz));
+	}
+#elif defined(MATH_USE_NEON)
+	const float32x4_t r00 = vdupq_n_f32(m00), r01 = vdupq_n_f32(m01), r02 = vdupq_n_f32(m02);
+	const float32x4_t r10 = vdupq_n_f32(m10), r11 = vdupq_n_f32(m11), r12 = vdupq_n_f32(m12);
+	const float32x4_t r20 = vdupq_n_f32(m20), r21 = vdupq_n_f32(m21), r22 = vdupq_n_f32(m22);
+	const float32x4_t rtx = vdupq_n_f32(tx), rty = vdupq_n_f32(ty), rtz = vdupq_n_f32(tz);
+
+	for (; i + 4 <= count; i += 4) {
+		const float32x4_t vx = vld1q_f32(x + i), vy = vld1q_f32(y + i), vz = vld1q_f32(z + i);
+		vst1q_f32(outX + i, vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(r00, vx), vmulq_f32(r01, vy)), vmulq_f32(r02, vz)), rtx));
+		vst1q_f32(outY + i, vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(r10, vx), vmulq_f32(r11, vy)), vmulq_f32(r12, vz)), rty));
+		vst1q_f32(outZ + i, vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(r20, vx), vmulq_f32(r21, vy)), vmulq_f32(r22, vz)), rtz));
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const float vx = x[i], vy = y[i], vz = z[i];
+		outX[i] = m00 * vx + m01 * vy + m02 * vz + tx;
+		outY[i] = m10 * vx + m11 * vy + m12 * vz + ty;
+		outZ[i] = m20 * vx + m21 * vy + m22 * vz + tz;
+	}
+}
+
+void Matrix<4, 4>::transformPoints(const Vector3d *in, Vector3d *out, int count, bool trans) const {
+	const float m00 = getValue(0, 0), m01 = getValue(0, 1), m02 = getValue(0, 2);
+	const float m10 = getValue(1, 0), m11 = getValue(1, 1), m12 = getValue(1, 2);
+	const float m20 = getValue(2, 0), m21 = getValue(2, 1), m22 = getValue(2, 2);
+	const float tx = trans ? getValue(0, 3) : 0.f;
+	const float ty = trans ? getValue(1, 3) : 0.f;
+	const float tz = trans ? getValue(2, 3) : 0.f;
+
+	for (int i = 0; i < count; ++i) {
+		const float vx = in[i].x(), vy = in[i].y(), vz = in[i].z();
+		out[i].set(m00 * vx + m01 * vy + m02 * vz + tx,
+		           m10 * vx + m11 * vy + m12 * vz + ty,
+		           m20 * vx + m21 * vy + m22 * vz + tz);
+	}
+}
 
-	m = *this * m;
+template<>
+Matrix<4, 4> operator*(const Matrix<4, 4> &m1, const Matrix<4, 4> &m2) {
+	Matrix<4, 4> result;
+	const float *a = m1.getData();
+	const float *b = m2.getData();
+	float *r = result.getData();
 
-	v->set(m(0, 0), m(1, 0), m(2, 0));
+	// Every row of the result is a combination of the rows of m2, weighted
+	// by the matching row of m1.
+#if defined(MATH_USE_SSE2)
+	const __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + 4), b2 = _mm_loadu_ps(b + 8), b3 = _mm_loadu_ps(b + 12);
+	for (int row = 0; row < 4; ++row) {
+		const float *ar = a + row * 4;
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(ar[0]), b0);
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(ar[1]), b1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(ar[2]), b2));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(ar[3]), b3));
+		_mm_storeu_ps(r + row * 4, sum);
+	}
+#elif defined(MATH_USE_NEON)
+	const float32x4_t b0 = vld1q_f32(b), b1 = vld1q_f32(b + 4), b2 = vld1q_f32(b + 8), b3 = vld1q_f32(b + 12);
+	for (int row = 0; row < 4; ++row) {
+		const float *ar = a + row * 4;
+		float32x4_t sum = vmulq_n_f32(b0, ar[0]);
+		sum = vaddq_f32(sum, vmulq_n_f32(b1, ar[1]));
+		sum = vaddq_f32(sum, vmulq_n_f32(b2, ar[2]));
+		sum = vaddq_f32(sum, vmulq_n_f32(b3, ar[3]));
+		vst1q_f32(r + row * 4, sum);
+	}
+#else
+	for (int row = 0; row < 4; ++row) {
+		const float *ar = a + row * 4;
+		for (int col = 0; col < 4; ++col) {
+			r[row * 4 + col] = ar[0] * b[col] + ar[1] * b[4 + col] + ar[2] * b[8 + col] + ar[3] * b[12 + col];
+		}
+	}
+#endif
+	return result;
 }
 
 Vector3d Matrix<4, 4>::getPosition() const {
@@ -129,13 +233,13 @@ void Matrix<4, 4>::invertAffineOrthonormal() {
 // Copyright (C)2000, 2001, Brett Porter. All Rights Reserved.
 // This source code is released under the LGPL. See license.txt for details.
 
-void Matrix<4, 4>::inverseTranslate(Vector3d *v) {
+void Matrix<4, 4>::inverseTranslate(Vector3d *v) const {
 	v->x() = v->x() - getValue(0, 3);
 	v->y() = v->y() - getValue(1, 3);
 	v->z() = v->z() - getValue(2, 3);
 }
 
-void Matrix<4, 4>::inverseRotate(Vector3d *v) {
+void Matrix<4, 4>::inverseRotate(Vector3d *v) const {
 	Vector3d temp;
 	
 	temp.x() = v->x() * getValue(0, 0) + v->y() * getValue(1, 0) + v->z() * getValue(2, 0);
@@ -38,8 +38,18 @@ public:
 	Matrix(const MatrixBase<4, 4> &m);
 
 	void transform(Vector3d *v, bool translate) const;
-	void inverseTranslate(Vector3d *v);
-	void inverseRotate(Vector3d *v);
+	void inverseTranslate(Vector3d *v) const;
+	void inverseRotate(Vector3d *v) const;
+
+	/**
+	 * Transforms a batch of points stored as separate x, y and z arrays.
+	 * The output arrays may be the input ones.
+	 */
+	void transformPoints(const float *x, const float *y, const float *z, float *outX, float *outY, float *outZ, int count, bool translate) const;
+	/**
+	 * Transforms count points from in and stores them in out, which may be in.
+	 */
+	void transformPoints(const Vector3d *in, Vector3d *out, int count, bool translate) const;
 	
 	Vector3d getPosition() const;
 	void setPosition(const Vector3d &v);
@@ -67,6 +77,12 @@ public:
 
 typedef Matrix<4, 4> Matrix4;
 
+/**
+ * 4x4 product, vectorized with SSE2 or NEON when they are available.
+ */
+template<>
+Matrix<4, 4> operator*(const Matrix<4, 4> &m1, const Matrix<4, 4> &m2);
+
 } // end of namespace Math
 
 #endif
@@ -3,7 +3,9 @@
 
 #include "audio/decoders/raw.h"
 
+#include "common/memstream.h"
 #include "common/stream.h"
+#include "common/util.h"
 #include "common/endian.h"
 
 #include <math.h>
@@ -0,0 +1,131 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/mp3.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+// Seeks in generated MPEG-1 Layer III streams and checks the samples left
+// against a linear decode of the whole stream. The frames are silent, so it
+// is the number of samples left which tells where the seek landed. The
+// checks only run when built with libmad.
+class MP3TestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kFrameSamples = 1152,
+		// Mono at 128 kbit/s, without padding
+		kFrameSize44k = 417,
+		kFrameSize48k = 384
+	};
+
+	byte *_data;
+	uint32 _size;
+
+	void createStream(const int *rates, int numRates, int framesPerRate) {
+		_size = 0;
+		for (int i = 0; i < numRates; i++)
+			_size += framesPerRate * (rates[i] == 48000 ? kFrameSize48k : kFrameSize44k);
+		_data = new byte[_size];
+		memset(_data, 0, _size);
+
+		// An all zero side info and main data decode as silence
+		byte *frame = _data;
+		for (int i = 0; i < numRates; i++) {
+			for (int j = 0; j < framesPerRate; j++) {
+				frame[0] = 0xff;
+				frame[1] = 0xfb;
+				frame[2] = rates[i] == 48000 ? 0x94 : 0x90;
+				frame[3] = 0xc0;
+				frame += rates[i] == 48000 ? kFrameSize48k : kFrameSize44k;
+			}
+		}
+	}
+
+#ifdef USE_MAD
+	static void readAll(Audio::AudioStream *stream, Common::Array<int16> &samples) {
+		int16 buffer[1000];
+		while (!stream->endOfData()) {
+			int read = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			for (int i = 0; i < read; i++)
+				samples.push_back(buffer[i]);
+			if (read <= 0)
+				break;
+		}
+	}
+
+	Audio::SeekableAudioStream *openStream() {
+		return Audio::makeMP3Stream(new Common::MemoryReadStream(_data, _size), DisposeAfterUse::YES);
+	}
+
+	// Seeking by time counts the frame headers after the one decoded last, so
+	// it lands on one of the next two frame starts, give or take the
+	// millisecond precision
+	static void checkTimeSeek(uint32 linearSize, uint32 size, uint32 sample, int rate) {
+		TS_ASSERT_LESS_THAN_EQUALS(size, linearSize - sample + rate / 1000);
+		TS_ASSERT_LESS_THAN(linearSize - sample, size + 2 * kFrameSamples + rate / 1000);
+	}
+
+	// Seek to the sample and compare what is left with the linear decode
+	void checkSeek(const Common::Array<int16> &linear, uint32 sample, int rate) {
+		Audio::SeekableAudioStream *stream = openStream();
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, sample, rate)));
+		Common::Array<int16> samples;
+		readAll(stream, samples);
+		delete stream;
+
+#ifdef MP3_SEEK_TABLE
+		TS_ASSERT_EQUALS(samples.size(), linear.size() - sample);
+#else
+		checkTimeSeek(linear.size(), samples.size(), sample, rate);
+#endif
+		for (uint i = 0; i < samples.size() && i < linear.size(); i++) {
+			if (samples[samples.size() - 1 - i] != linear[linear.size() - 1 - i]) {
+				TS_FAIL("The samples after seeking differ from the linear decode");
+				break;
+			}
+		}
+	}
+#endif
+
+	public:
+	MP3TestSuite() : _data(0), _size(0) {}
+
+	void test_seek() {
+		const int rates[] = { 44100 };
+		createStream(rates, ARRAYSIZE(rates), 40);
+#ifdef USE_MAD
+		Audio::SeekableAudioStream *stream = openStream();
+		Common::Array<int16> linear;
+		readAll(stream, linear);
+		delete stream;
+		TS_ASSERT_LESS_THAN(38u * kFrameSamples, linear.size());
+
+		const uint32 samples[] = { 0, 1, 1151, 1152, 5000, 20000, 38 * kFrameSamples - 100 };
+		for (uint i = 0; i < ARRAYSIZE(samples); i++)
+			checkSeek(linear, samples[i], 44100);
+#endif
+		delete[] _data;
+	}
+
+	// The sample rate changes and then comes back, so a table of the frames
+	// can't be used
+	void test_seekRateChange() {
+		const int rates[] = { 44100, 48000, 44100 };
+		createStream(rates, ARRAYSIZE(rates), 10);
+#ifdef USE_MAD
+		Audio::SeekableAudioStream *stream = openStream();
+		Common::Array<int16> linear;
+		readAll(stream, linear);
+		delete stream;
+
+		stream = openStream();
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, 2000, 44100)));
+		Common::Array<int16> samples;
+		readAll(stream, samples);
+		delete stream;
+		checkTimeSeek(linear.size(), samples.size(), 2000, 44100);
+#endif
+		delete[] _data;
+	}
+};
@@ -0,0 +1,38 @@
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+// The benchmarks are standalone programs without an OSystem, so they time
+// themselves with the C library
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
+#include "common/scummsys.h"
+
+#include <time.h>
+#include <stdio.h>
+
+namespace Benchmark {
+
+/**
+ * Processor time used so far, in seconds.
+ */
+inline double getSeconds() {
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+inline void printHeader(const char *title) {
+	printf("%-32s %14s %14s %8s\n", title, "reference", "current", "speedup");
+}
+
+/**
+ * Print how many million items per second the reference and the current
+ * code processed.
+ */
+inline void printResult(const char *name, double items, double referenceTime, double currentTime) {
+	printf("%-32s %10.1f M/s %10.1f M/s %7.2fx\n", name, items / referenceTime / 1e6,
+	       items / currentTime / 1e6, referenceTime / currentTime);
+}
+
+} // end of namespace Benchmark
+
+#endif
@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+// Compresses a few megabytes of generated data and reads them back with
+// seeks in both directions, across the checkpoints the decompressor keeps.
+class ZlibTestSuite : public CxxTest::TestSuite {
+	enum {
+		kSize = 6 * 1024 * 1024,
+		kChunk = 1000,
+		kSeeks = 200
+	};
+
+	uint32 _seed;
+
+	uint32 next(uint32 range) {
+		_seed = _seed * 1103515245 + 12345;
+		return ((_seed >> 16) & 0x7fff) % range;
+	}
+
+	static byte valueAt(uint32 pos) {
+		return (byte)(((pos >> 3) * 2654435761u) >> 24);
+	}
+
+	bool readAt(Common::SeekableReadStream *stream, uint32 pos) {
+		byte buf[kChunk];
+		stream->seek(pos, SEEK_SET);
+		if (stream->pos() != (int32)pos || stream->read(buf, kChunk) != kChunk)
+			return false;
+		for (uint32 i = 0; i < kChunk; i++) {
+			if (buf[i] != valueAt(pos + i))
+				return false;
+		}
+		return true;
+	}
+
+	public:
+	ZlibTestSuite() : _seed(1) {}
+
+	void test_seek() {
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *out = Common::wrapCompressedWriteStream(compressed);
+		byte buf[4096];
+		for (uint32 pos = 0; pos < kSize; pos += sizeof(buf)) {
+			for (uint32 i = 0; i < sizeof(buf); i++)
+				buf[i] = valueAt(pos + i);
+			out->write(buf, sizeof(buf));
+		}
+		out->finalize();
+		byte *data = compressed->getData();
+		uint32 size = compressed->size();
+		delete out;
+
+		Common::SeekableReadStream *in = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(data, size, DisposeAfterUse::YES), kSize);
+		TS_ASSERT(readAt(in, kSize - kChunk));
+		for (int i = 0; i < kSeeks; i++)
+			TS_ASSERT(readAt(in, next(kSize / 16 - kChunk / 16) * 16));
+		TS_ASSERT(readAt(in, 0));
+		delete in;
+	}
+};
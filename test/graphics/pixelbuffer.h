@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelbuffer.h"
+
+class PixelBufferTestSuite : public CxxTest::TestSuite
+{
+	// Small deterministic generator, so that failures are reproducible
+	uint32 _seed;
+
+	uint32 nextValue() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) | (_seed << 16);
+	}
+
+	void fill(Graphics::PixelBuffer &buf, int length) {
+		for (int i = 0; i < length; ++i)
+			buf.setPixelAt(i, nextValue() & (0xFFFFFFFF >> (32 - 8 * buf.getFormat().bytesPerPixel)));
+	}
+
+	// Convert both with copyBuffer() and with the per pixel conversions it stands for
+	void checkConversion(const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &dstFormat) {
+		// An odd length, and copies not starting at the first pixel
+		const int length = 37;
+		Graphics::PixelBuffer src(srcFormat, length + 3, DisposeAfterUse::YES);
+		Graphics::PixelBuffer dst(dstFormat, length + 5, DisposeAfterUse::YES);
+		Graphics::PixelBuffer keyed(dstFormat, length + 5, DisposeAfterUse::YES);
+		fill(src, length + 3);
+		const uint32 key = src.getValueAt(10);
+
+		dst.copyBuffer(5, 3, length, src);
+		keyed.copyBufferKeyed(5, 3, length, src, key);
+
+		Graphics::PixelBuffer ref(dstFormat, 1, DisposeAfterUse::YES);
+		for (int i = 0; i < length; ++i) {
+			uint8 r, g, b;
+			src.getRGBAt(i + 3, r, g, b);
+			ref.setPixelAt(0, r, g, b);
+			TS_ASSERT_EQUALS(dst.getValueAt(i + 5), ref.getValueAt(0));
+
+			if (src.getValueAt(i + 3) == key)
+				ref.setPixelAt(0, key);
+			else
+				ref.setPixelAt(0, src, i + 3);
+			TS_ASSERT_EQUALS(keyed.getValueAt(i + 5), ref.getValueAt(0));
+		}
+	}
+
+	public:
+	PixelBufferTestSuite() : _seed(1) {}
+
+	void test_conversions() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 0, 8, 16, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+		const int count = sizeof(formats) / sizeof(formats[0]);
+
+		// Copies between the same formats are plain copies
+		for (int i = 0; i < count; ++i) {
+			for (int j = 0; j < count; ++j) {
+				if (i != j)
+					checkConversion(formats[i], formats[j]);
+			}
+		}
+	}
+
+	void test_values() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+
+		for (int i = 0; i < 3; ++i) {
+			const int bpp = formats[i].bytesPerPixel;
+			Graphics::PixelBuffer buf(formats[i], 2, DisposeAfterUse::YES);
+			const uint32 value = 0x12345678 & (0xFFFFFFFF >> (32 - 8 * bpp));
+			buf.setPixelAt(1, value);
+			TS_ASSERT_EQUALS(buf.getValueAt(1), value);
+
+			// The values are stored in the native byte order
+			const byte *raw = buf.getRawBuffer(1);
+			for (int b = 0; b < bpp; ++b) {
+#ifdef SCUMM_BIG_ENDIAN
+				TS_ASSERT_EQUALS(raw[b], (value >> (8 * (bpp - b - 1))) & 0xFF);
+#else
+				TS_ASSERT_EQUALS(raw[b], (value >> (8 * b)) & 0xFF);
+#endif
+			}
+		}
+	}
+};
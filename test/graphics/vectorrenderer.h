@@ -0,0 +1,127 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/VectorRendererSpec.h"
+
+// Draws generated shapes over a noisy background and compares a hash of the
+// result with the one the original per pixel loops produced, so that the
+// span kernels stay bit-exact. Paths which query g_system are left out.
+class VectorRendererTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kWidth = 200,
+		kHeight = 150,
+		kShapes = 400
+	};
+
+	uint32 _seed;
+
+	uint32 next(uint32 range) {
+		_seed = _seed * 1103515245 + 12345;
+		return ((_seed >> 16) & 0x7fff) % range;
+	}
+
+	void fillNoise(Graphics::Surface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			uint16 *row = (uint16 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; x++)
+				row[x] = (next(256) << 8) | next(256);
+		}
+	}
+
+	static uint32 hashSurface(const Graphics::Surface &surface) {
+		uint32 hash = 2166136261u;
+		for (int y = 0; y < surface.h; y++) {
+			const byte *row = (const byte *)surface.getBasePtr(0, y);
+			for (int i = 0; i < surface.w * surface.format.bytesPerPixel; i++)
+				hash = (hash ^ row[i]) * 16777619u;
+		}
+		return hash;
+	}
+
+	void drawShapes(Graphics::VectorRenderer *renderer, bool antialias) {
+		for (int i = 0; i < kShapes; i++) {
+			int w = 4 + next(80);
+			int h = 4 + next(60);
+			int x = next(kWidth - w - 12);
+			int y = next(kHeight - h - 12);
+			int shape = next(5);
+			int fill = next(4);
+
+			// Gradients on antialiased rounded squares depend on the overlay features
+			if (antialias && shape == 1 && fill == Graphics::VectorRenderer::kFillGradient)
+				fill = Graphics::VectorRenderer::kFillBackground;
+
+			renderer->setFgColor(next(256), next(256), next(256));
+			renderer->setBgColor(next(256), next(256), next(256));
+			renderer->setBevelColor(next(256), next(256), next(256));
+			renderer->setGradientColors(next(256), next(256), next(256), next(256), next(256), next(256));
+			renderer->setGradientFactor(1 + next(3));
+			renderer->setStrokeWidth(next(3));
+			renderer->setShadowOffset(next(5));
+			renderer->setBevel(next(3));
+			renderer->setFillMode((Graphics::VectorRenderer::FillMode)fill);
+
+			switch (shape) {
+			case 0:
+				renderer->drawSquare(x, y, w, h);
+				break;
+			case 1:
+				renderer->drawRoundedSquare(x, y, 1 + next(8), w, h);
+				break;
+			case 2:
+				renderer->drawCircle(x + w / 2, y + h / 2, MIN(w, h) / 2);
+				break;
+			case 3:
+				renderer->drawLine(x, y, x + w, y + h);
+				break;
+			case 4:
+				renderer->setFillMode(Graphics::VectorRenderer::kFillDisabled);
+				renderer->drawBeveledSquare(x + 3, y + 3, w, h, 1 + next(3));
+				break;
+			}
+		}
+	}
+
+	uint32 render(const Graphics::PixelFormat &format, bool antialias) {
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, format);
+		fillNoise(surface);
+
+		Graphics::VectorRenderer *renderer;
+		if (antialias)
+			renderer = new Graphics::VectorRendererAA<uint16>(format);
+		else
+			renderer = new Graphics::VectorRendererSpec<uint16>(format);
+		renderer->setSurface(&surface);
+
+		drawShapes(renderer, antialias);
+
+		renderer->setGradientColors(10, 200, 30, 240, 20, 90);
+		renderer->setGradientFactor(1);
+		renderer->setFillMode(Graphics::VectorRenderer::kFillGradient);
+		renderer->setShadowOffset(0);
+		renderer->drawSquare(20, 10, 150, 120);
+		renderer->applyScreenShading(GUI::ThemeEngine::kShadingDim);
+
+		uint32 hash = hashSurface(surface);
+		delete renderer;
+		surface.free();
+		return hash;
+	}
+
+	public:
+	VectorRendererTestSuite() : _seed(1) {}
+
+	void test_rgb565() {
+		Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		TS_ASSERT_EQUALS(render(format, false), 2677030166u);
+		TS_ASSERT_EQUALS(render(format, true), 40954966u);
+	}
+
+	void test_argb4444() {
+		Graphics::PixelFormat format(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		TS_ASSERT_EQUALS(render(format, false), 1537232114u);
+		TS_ASSERT_EQUALS(render(format, true), 3514511233u);
+	}
+};
@@ -0,0 +1,68 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/endian.h"
+
+#include "engines/grim/movie/codecs/vima.h"
+
+// Decodes generated VIMA streams and compares a hash of the samples with the
+// one the original sample by sample decoder produced.
+class VimaTestSuite : public CxxTest::TestSuite
+{
+	uint32 _seed;
+
+	uint32 next() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) & 0x7fff;
+	}
+
+	static uint32 hashSamples(uint32 hash, const int16 *data, int count) {
+		const byte *bytes = (const byte *)data;
+		for (int i = 0; i < count * 2; i++)
+			hash = (hash ^ bytes[i]) * 16777619u;
+		return hash;
+	}
+
+	uint32 decodeStreams(bool stereo) {
+		enum {
+			kSrcSize = 16384,
+			kSamples = 8192
+		};
+		byte *src = new byte[kSrcSize];
+		int16 *dst = new int16[kSamples];
+		uint32 hash = 2166136261u;
+
+		_seed = stereo ? 2 : 1;
+		Grim::vimaInit();
+		for (int stream = 0; stream < 16; stream++) {
+			for (int i = 0; i < kSrcSize; i++)
+				src[i] = next() & 0xff;
+			// The initial step indices, in range, the first one telling the
+			// number of channels
+			src[0] = next() % 89;
+			if (stereo) {
+				src[0] = ~src[0];
+				src[3] = next() % 89;
+			}
+
+			// Some lengths which don't end on a whole byte of input
+			int destLen = kSamples * 2 - (stream % 4) * 2 * (stereo ? 2 : 1);
+			Grim::decompressVima(src, dst, destLen);
+			hash = hashSamples(hash, dst, destLen / 2);
+		}
+
+		delete[] src;
+		delete[] dst;
+		return hash;
+	}
+
+	public:
+	VimaTestSuite() : _seed(0) {}
+
+	void test_mono() {
+		TS_ASSERT_EQUALS(decodeStreams(false), 4274785140u);
+	}
+
+	void test_stereo() {
+		TS_ASSERT_EQUALS(decodeStreams(true), 1342304794u);
+	}
+};
@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "math/matrix4.h"
+#include "math/vector4d.h"
+
+class Matrix4TestSuite : public CxxTest::TestSuite
+{
+	// Small deterministic generator, so that failures are reproducible
+	uint32 _seed;
+
+	float nextFloat() {
+		_seed = _seed * 1103515245 + 12345;
+		return (int)((_seed >> 16) & 0x7fff) / 4096.0f - 4.0f;
+	}
+
+	void fillMatrix(Math::Matrix4 &m) {
+		float *data = m.getData();
+		for (int i = 0; i < 16; ++i)
+			data[i] = nextFloat();
+	}
+
+	// The plain row by column product, as done by the generic template
+	static Math::Matrix4 referenceProduct(const Math::Matrix4 &m1, const Math::Matrix4 &m2) {
+		Math::Matrix4 result;
+		for (int row = 0; row < 4; ++row) {
+			for (int col = 0; col < 4; ++col) {
+				float sum = 0.0f;
+				for (int j = 0; j < 4; ++j)
+					sum += m1.getValue(row, j) * m2.getValue(j, col);
+				result.setValue(row, col, sum);
+			}
+		}
+		return result;
+	}
+
+	static Math::Vector3d referenceTransform(const Math::Matrix4 &m, const Math::Vector3d &v, bool translate) {
+		Math::Vector4d v4(v.x(), v.y(), v.z(), translate ? 1.f : 0.f);
+		Math::Vector4d r = m * v4;
+		return Math::Vector3d(r.x(), r.y(), r.z());
+	}
+
+	public:
+	Matrix4TestSuite() : _seed(1) {}
+
+	void test_product() {
+		for (int i = 0; i < 100; ++i) {
+			Math::Matrix4 a, b;
+			fillMatrix(a);
+			fillMatrix(b);
+			Math::Matrix4 fast = a * b;
+			Math::Matrix4 ref = referenceProduct(a, b);
+			for (int j = 0; j < 16; ++j)
+				TS_ASSERT_EQUALS(fast.getData()[j], ref.getData()[j]);
+		}
+	}
+
+	void test_transform() {
+		Math::Matrix4 m;
+		fillMatrix(m);
+		for (int i = 0; i < 100; ++i) {
+			Math::Vector3d v(nextFloat(), nextFloat(), nextFloat());
+			for (int translate = 0; translate < 2; ++translate) {
+				Math::Vector3d fast = v;
+				m.transform(&fast, translate);
+				Math::Vector3d ref = referenceTransform(m, v, translate);
+				TS_ASSERT_DELTA(fast.x(), ref.x(), 1e-5f);
+				TS_ASSERT_DELTA(fast.y(), ref.y(), 1e-5f);
+				TS_ASSERT_DELTA(fast.z(), ref.z(), 1e-5f);
+			}
+		}
+	}
+
+	void test_transformPoints() {
+		// An odd count also covers the scalar tail of the vector loops
+		const int count = 37;
+		float x[count], y[count], z[count];
+		float outX[count], outY[count], outZ[count];
+		Math::Vector3d points[count];
+		Math::Matrix4 m;
+		fillMatrix(m);
+
+		for (int i = 0; i < count; ++i) {
+			x[i] = nextFloat();
+			y[i] = nextFloat();
+			z[i] = nextFloat();
+			points[i].set(x[i], y[i], z[i]);
+		}
+
+		m.transformPoints(x, y, z, outX, outY, outZ, count, true);
+		m.transformPoints(points, points, count, true);
+		for (int i = 0; i < count; ++i) {
+			Math::Vector3d v(x[i], y[i], z[i]);
+			m.transform(&v, true);
+			TS_ASSERT_EQUALS(outX[i], v.x());
+			TS_ASSERT_EQUALS(outY[i], v.y());
+			TS_ASSERT_EQUALS(outZ[i], v.z());
+			TS_ASSERT_EQUALS(points[i].x(), v.x());
+			TS_ASSERT_EQUALS(points[i].y(), v.y());
+			TS_ASSERT_EQUALS(points[i].z(), v.z());
+		}
+
+		// In place, without translation
+		for (int i = 0; i < count; ++i)
+			points[i].set(x[i], y[i], z[i]);
+		m.transformPoints(x, y, z, x, y, z, count, false);
+		for (int i = 0; i < count; ++i) {
+			Math::Vector3d v = referenceTransform(m, points[i], false);
+			TS_ASSERT_DELTA(x[i], v.x(), 1e-5f);
+			TS_ASSERT_DELTA(y[i], v.y(), 1e-5f);
+			TS_ASSERT_DELTA(z[i], v.z(), 1e-5f);
+		}
+	}
+};
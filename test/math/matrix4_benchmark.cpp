@@ -0,0 +1,260 @@
+#include "test/benchmark.h"
+
+#include "common/util.h"
+
+#include "math/matrix4.h"
+#include "math/quat.h"
+#include "math/vector4d.h"
+
+#include <math.h>
+
+// Times the Matrix4 and Quaternion calls the renderers use against plain
+// scalar versions of the same operations: the row by column product of the
+// generic template, points transformed through a 4x1 matrix product, a
+// Gauss-Jordan inverse and the slerp formula through the generic vector
+// operators. slerpQuat itself is still scalar, so its line is a baseline.
+
+enum {
+	kPoints = 4096,
+	kPointRounds = 2048,
+	kMatrices = 1024,
+	kMatrixRounds = 2048
+};
+
+static uint32 seed = 1;
+static volatile float sink;
+
+static float nextFloat() {
+	seed = seed * 1103515245 + 12345;
+	return (int)((seed >> 16) & 0x7fff) / 4096.0f - 4.0f;
+}
+
+static void fillMatrix(Math::Matrix4 &m) {
+	float *data = m.getData();
+	for (int i = 0; i < 16; ++i)
+		data[i] = nextFloat();
+}
+
+static Math::Matrix4 referenceProduct(const Math::Matrix4 &m1, const Math::Matrix4 &m2) {
+	Math::Matrix4 result;
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			float sum = 0.0f;
+			for (int j = 0; j < 4; ++j)
+				sum += m1.getValue(row, j) * m2.getValue(j, col);
+			result.setValue(row, col, sum);
+		}
+	}
+	return result;
+}
+
+static Math::Vector3d referenceTransform(const Math::Matrix4 &m, const Math::Vector3d &v) {
+	Math::Vector4d v4(v.x(), v.y(), v.z(), 1.f);
+	Math::Vector4d r = m * v4;
+	return Math::Vector3d(r.x(), r.y(), r.z());
+}
+
+static Math::Matrix4 referenceInverse(const Math::Matrix4 &m) {
+	float a[4][8];
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			a[row][col] = m.getValue(row, col);
+			a[row][col + 4] = row == col ? 1.f : 0.f;
+		}
+	}
+	for (int col = 0; col < 4; ++col) {
+		int pivot = col;
+		for (int row = col + 1; row < 4; ++row) {
+			if (fabs(a[row][col]) > fabs(a[pivot][col]))
+				pivot = row;
+		}
+		for (int j = 0; j < 8; ++j)
+			SWAP(a[col][j], a[pivot][j]);
+		float scale = 1.f / a[col][col];
+		for (int j = 0; j < 8; ++j)
+			a[col][j] *= scale;
+		for (int row = 0; row < 4; ++row) {
+			if (row == col)
+				continue;
+			float factor = a[row][col];
+			for (int j = 0; j < 8; ++j)
+				a[row][j] -= factor * a[col][j];
+		}
+	}
+	Math::Matrix4 result;
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col)
+			result.setValue(row, col, a[row][col + 4]);
+	}
+	return result;
+}
+
+static Math::Vector4d referenceSlerp(const Math::Vector4d &from, const Math::Vector4d &to, float t) {
+	float co = from.x() * to.x() + from.y() * to.y() + from.z() * to.z() + from.w() * to.w();
+	float sign = 1.f;
+	if (co < 0.f) {
+		co = -co;
+		sign = -1.f;
+	}
+	float scale0 = 1.f - t, scale1 = t;
+	if (co < 1.f - 1e-6f) {
+		double o = acos((double)co);
+		double so = 1.0 / sin(o);
+		scale0 = (float)(sin((1.0 - t) * o) * so);
+		scale1 = (float)(sin(t * o) * so);
+	}
+	return from * scale0 + to * (scale1 * sign);
+}
+
+static void benchmarkTransform() {
+	float *x = new float[kPoints];
+	float *y = new float[kPoints];
+	float *z = new float[kPoints];
+	float *outX = new float[kPoints];
+	float *outY = new float[kPoints];
+	float *outZ = new float[kPoints];
+	Math::Vector3d *points = new Math::Vector3d[kPoints];
+	Math::Vector3d *out = new Math::Vector3d[kPoints];
+	Math::Matrix4 m;
+	fillMatrix(m);
+	for (int i = 0; i < kPoints; ++i) {
+		x[i] = nextFloat();
+		y[i] = nextFloat();
+		z[i] = nextFloat();
+		points[i].set(x[i], y[i], z[i]);
+	}
+
+	const double items = (double)kPoints * kPointRounds;
+	double start = Benchmark::getSeconds();
+	for (int round = 0; round < kPointRounds; ++round) {
+		for (int i = 0; i < kPoints; ++i)
+			out[i] = referenceTransform(m, points[i]);
+		sink += out[round % kPoints].x();
+	}
+	double referenceTime = Benchmark::getSeconds() - start;
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kPointRounds; ++round) {
+		for (int i = 0; i < kPoints; ++i) {
+			out[i] = points[i];
+			m.transform(&out[i], true);
+		}
+		sink += out[round % kPoints].x();
+	}
+	Benchmark::printResult("Matrix4::transform", items, referenceTime, Benchmark::getSeconds() - start);
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kPointRounds; ++round) {
+		m.transformPoints(points, out, kPoints, true);
+		sink += out[round % kPoints].x();
+	}
+	Benchmark::printResult("Matrix4::transformPoints, AoS", items, referenceTime, Benchmark::getSeconds() - start);
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kPointRounds; ++round) {
+		m.transformPoints(x, y, z, outX, outY, outZ, kPoints, true);
+		sink += outX[round % kPoints];
+	}
+	Benchmark::printResult("Matrix4::transformPoints, SoA", items, referenceTime, Benchmark::getSeconds() - start);
+
+	delete[] x;
+	delete[] y;
+	delete[] z;
+	delete[] outX;
+	delete[] outY;
+	delete[] outZ;
+	delete[] points;
+	delete[] out;
+}
+
+static void benchmarkMatrices() {
+	Math::Matrix4 *a = new Math::Matrix4[kMatrices];
+	Math::Matrix4 *b = new Math::Matrix4[kMatrices];
+	Math::Matrix4 *out = new Math::Matrix4[kMatrices];
+	for (int i = 0; i < kMatrices; ++i) {
+		fillMatrix(a[i]);
+		// Rotations and translations, which both inverses handle
+		b[i].setPosition(Math::Vector3d(nextFloat(), nextFloat(), nextFloat()));
+		b[i].buildFromPitchYawRoll(nextFloat() * 45, nextFloat() * 45, nextFloat() * 45);
+	}
+
+	const double items = (double)kMatrices * kMatrixRounds;
+	double start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		for (int i = 0; i < kMatrices; ++i)
+			out[i] = referenceProduct(a[i], b[i]);
+		sink += out[round % kMatrices].getData()[round % 16];
+	}
+	double referenceTime = Benchmark::getSeconds() - start;
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		for (int i = 0; i < kMatrices; ++i)
+			out[i] = a[i] * b[i];
+		sink += out[round % kMatrices].getData()[round % 16];
+	}
+	Benchmark::printResult("Matrix4 * Matrix4", items, referenceTime, Benchmark::getSeconds() - start);
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		for (int i = 0; i < kMatrices; ++i)
+			out[i] = referenceInverse(b[i]);
+		sink += out[round % kMatrices].getData()[round % 16];
+	}
+	referenceTime = Benchmark::getSeconds() - start;
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		for (int i = 0; i < kMatrices; ++i) {
+			out[i] = b[i];
+			out[i].invertAffineOrthonormal();
+		}
+		sink += out[round % kMatrices].getData()[round % 16];
+	}
+	Benchmark::printResult("Matrix4::invertAffineOrthonormal", items, referenceTime, Benchmark::getSeconds() - start);
+
+	delete[] a;
+	delete[] b;
+	delete[] out;
+}
+
+static void benchmarkSlerp() {
+	Math::Quaternion *from = new Math::Quaternion[kMatrices];
+	Math::Quaternion *to = new Math::Quaternion[kMatrices];
+	Math::Vector4d *out = new Math::Vector4d[kMatrices];
+	for (int i = 0; i < kMatrices; ++i) {
+		from[i] = Math::Quaternion::fromEuler(nextFloat() * 45, nextFloat() * 45, nextFloat() * 45);
+		to[i] = Math::Quaternion::fromEuler(nextFloat() * 45, nextFloat() * 45, nextFloat() * 45);
+	}
+
+	const double items = (double)kMatrices * kMatrixRounds;
+	double start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		float t = (round % 64) / 64.f;
+		for (int i = 0; i < kMatrices; ++i)
+			out[i] = referenceSlerp(from[i], to[i], t);
+		sink += out[round % kMatrices].x();
+	}
+	double referenceTime = Benchmark::getSeconds() - start;
+
+	start = Benchmark::getSeconds();
+	for (int round = 0; round < kMatrixRounds; ++round) {
+		float t = (round % 64) / 64.f;
+		for (int i = 0; i < kMatrices; ++i)
+			out[i] = from[i].slerpQuat(to[i], t);
+		sink += out[round % kMatrices].x();
+	}
+	Benchmark::printResult("Quaternion::slerpQuat", items, referenceTime, Benchmark::getSeconds() - start);
+
+	delete[] from;
+	delete[] to;
+	delete[] out;
+}
+
+int main() {
+	Benchmark::printHeader("Math");
+	benchmarkTransform();
+	benchmarkMatrices();
+	benchmarkSlerp();
+	return 0;
+}
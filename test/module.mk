@@ -1,12 +1,15 @@
 ######################################################################
 # Unit/regression tests, based on CxxTest.
 # Use the 'test' target to run them.
+# The 'benchmark' target builds and runs the standalone micro-benchmarks;
+# configure with --enable-optimizations to get meaningful timings.
 # Edit TESTS and TESTLIBS to add more tests.
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/grim/*.h
+BENCHMARKS   := test/math/matrix4_benchmark test/grim/vima_benchmark
+TEST_LIBS    := engines/grim/libgrim.a audio/libaudio.a graphics/libgraphics.a math/libmath.a common/libcommon.a
 
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
@@ -34,9 +37,14 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+benchmark: $(BENCHMARKS)
+	@for benchmark in $(BENCHMARKS); do ./$$benchmark || exit 1; done
+test/%_benchmark: $(srcdir)/test/%_benchmark.cpp $(TEST_LIBS)
+	@mkdir -p $(dir $@)
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
 
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner $(BENCHMARKS)
 
-.PHONY: test clean-test
+.PHONY: test benchmark clean-test
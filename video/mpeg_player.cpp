@@ -189,6 +189,15 @@ bool BaseAnimationState::decodeFrame() {
 	return false;
 }
 
+uint32 BaseAnimationState::getFramePeriod() const {
+#ifdef USE_MPEG2
+	// The period is given in ticks of the 27 MHz system clock
+	if (_mpegInfo && _mpegInfo->sequence)
+		return _mpegInfo->sequence->frame_period / 27;
+#endif
+	return 0;
+}
+
 bool BaseAnimationState::checkPaletteSwitch() {
 	return false;
 }
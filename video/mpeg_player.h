@@ -120,6 +120,9 @@ public:
 	int getFrameWidth() { return _frameWidth; }
 	int getFrameHeight() { return _frameHeight; }
 
+	/** Time each frame is shown for, in microseconds, or 0 before the sequence header was read. */
+	uint32 getFramePeriod() const;
+
 protected:
 	bool checkPaletteSwitch();
 	virtual void drawYUV(int width, int height, byte *const *dat) = 0;